@@ -9,7 +9,7 @@ AlgorithmResult evaluateAlgorithm(
     const std::string& name,
     int n,
     int selectCount,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     std::function<std::vector<int>(int)> algorithmFunc
 ) {
@@ -20,6 +20,7 @@ AlgorithmResult evaluateAlgorithm(
     result.maxTime = 0;
     long long sumObj = 0;
     double sumTime = 0;
+    lsCountersReset();
     
     for (int start = 0; start < n; start++) {
         auto startTime = std::chrono::high_resolution_clock::now();
@@ -49,14 +50,60 @@ AlgorithmResult evaluateAlgorithm(
     
     result.avgObj = sumObj / n;
     result.avgTime = sumTime / n;
+    result.counters = lsCountersSnapshot();
     return result;
 }
 
-void printAlgorithmResult(const std::string& name, const AlgorithmResult& result) {
+AlgorithmResult evaluateBatch(const BatchSolutions& batch, const DistanceMatrix& distance, const std::vector<int>& costs) {
+    AlgorithmResult result;
+    result.minObj = INT_MAX;
+    result.maxObj = 0;
+    result.minTime = DBL_MAX;
+    result.maxTime = 0;
+    long long sumObj = 0;
+    double sumTime = 0;
+    int runs = batch.solutions.size();
+    
+    for (int run = 0; run < runs; run++) {
+        int obj = calculateObjective(batch.solutions[run], distance, costs);
+        double timeMs = batch.timesMs[run];
+        
+        sumObj += obj;
+        sumTime += timeMs;
+        
+        if (obj < result.minObj) {
+            result.minObj = obj;
+            result.bestSolution = batch.solutions[run];
+        }
+        if (obj > result.maxObj) {
+            result.maxObj = obj;
+        }
+        if (timeMs < result.minTime) {
+            result.minTime = timeMs;
+        }
+        if (timeMs > result.maxTime) {
+            result.maxTime = timeMs;
+        }
+    }
+    
+    result.avgObj = sumObj / runs;
+    result.avgTime = sumTime / runs;
+    return result;
+}
+
+void printAlgorithmResult(const std::string& name, const AlgorithmResult& result,
+                          const std::vector<int>& originalIds) {
     std::cout << name << ":\n";
     std::cout << "  Objective: Min=" << result.minObj << ", Max=" << result.maxObj << ", Avg=" << result.avgObj << "\n";
     std::cout << "  Time (ms): Min=" << result.minTime << ", Max=" << result.maxTime << ", Avg=" << result.avgTime << "\n";
+    if (!result.counters.empty()) {
+        const LSCounters& c = result.counters;
+        std::cout << "  Moves: Deltas=" << c.deltaEvaluations << ", Improving=" << c.improvingMoves
+                  << ", Applied intra=" << c.intraApplied << ", Applied exchange=" << c.exchangeApplied
+                  << ", Candidate checks=" << c.candidateChecks << ", Stale discarded=" << c.staleDiscarded
+                  << ", List high-water=" << c.listHighWater << "\n";
+    }
     std::cout << "  Best: ";
-    for (int node : result.bestSolution) std::cout << node << " ";
+    for (int node : result.bestSolution) std::cout << (originalIds.empty() ? node : originalIds[node]) << " ";
     std::cout << "\n\n" << std::flush;
 }
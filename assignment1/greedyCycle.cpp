@@ -1,52 +1,54 @@
 #include "../include/greedyCycle.h"
+#include "../include/insertionCache.h"
 #include <climits>
 
-std::vector<int> greedyCycle(int startNode, int selectCount, const std::vector<std::vector<int>>& distance, const std::vector<int>& costs) {
+namespace {
+
+std::vector<int> buildCycle(int startNode, int selectCount, const DistanceMatrix& distance, const std::vector<int>& costs,
+                            InsertionCache& cache, const NeighborRanking* ranking) {
     std::vector<int> solution;
-    std::vector<bool> selected(distance.size(), false);
-    
     solution.push_back(startNode);
-    selected[startNode] = true;
     
     if (selectCount > 1) {
-        int bestNode = -1;
-        int bestDist = INT_MAX;
-        for (int i = 0; i < distance.size(); i++) {
-            if (selected[i]) continue;
-            int delta = distance[startNode][i] + costs[i];
-            if (delta < bestDist) {
-                bestDist = delta;
-                bestNode = i;
-            }
-        }
-        solution.push_back(bestNode);
-        selected[bestNode] = true;
+        std::vector<bool> selected(distance.size(), false);
+        selected[startNode] = true;
+        solution.push_back(cheapestUnselected(startNode, selected, distance, costs, ranking));
     }
     
-    while (solution.size() < selectCount) {
+    // Best insertion of every unselected node, updated incrementally after each insertion
+    cache.reset(solution);
+    while (cache.size() < selectCount) {
         int bestNode = -1;
-        int bestPos = -1;
         int bestDelta = INT_MAX;
         
         for (int i = 0; i < distance.size(); i++) {
-            if (selected[i]) continue;
-            
-            for (int pos = 0; pos < solution.size(); pos++) {
-                int next = (pos + 1) % solution.size();
-                int delta = distance[solution[pos]][i] + distance[i][solution[next]] 
-                           - distance[solution[pos]][solution[next]] + costs[i];
-                
-                if (delta < bestDelta) {
-                    bestDelta = delta;
-                    bestNode = i;
-                    bestPos = pos + 1;
-                }
+            if (cache.selected(i)) continue;
+            if (cache.best1(i) < bestDelta) {
+                bestDelta = cache.best1(i);
+                bestNode = i;
             }
         }
         
-        solution.insert(solution.begin() + bestPos, bestNode);
-        selected[bestNode] = true;
+        cache.insertAfter(bestNode, cache.bestAfter(bestNode));
     }
     
-    return solution;
+    return cache.toVector();
+}
+
+}
+
+std::vector<int> greedyCycle(int startNode, int selectCount, const DistanceMatrix& distance, const std::vector<int>& costs,
+                             const NeighborRanking* ranking) {
+    InsertionCache cache(distance, costs);
+    return buildCycle(startNode, selectCount, distance, costs, cache, ranking);
+}
+
+BatchSolutions greedyCycleBatch(const std::vector<int>& starts, int selectCount, const DistanceMatrix& distance,
+                                const std::vector<int>& costs, int threads) {
+    NeighborRanking ranking(distance, costs, 1);
+    std::function<InsertionCache()> makeWorkspace = [&]() { return InsertionCache(distance, costs); };
+    std::function<std::vector<int>(int, InsertionCache&)> build = [&](int start, InsertionCache& cache) {
+        return buildCycle(start, selectCount, distance, costs, cache, &ranking);
+    };
+    return buildBatch(starts, batchThreads(distance, threads), makeWorkspace, build);
 }
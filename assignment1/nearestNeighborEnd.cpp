@@ -1,30 +1,37 @@
 #include "../include/nearestNeighborEnd.h"
-#include <climits>
 
-std::vector<int> nearestNeighborEnd(int startNode, int selectCount, const std::vector<std::vector<int>>& distance, const std::vector<int>& costs) {
+namespace {
+
+// Grow the path from startNode; selected must be all zero and is left all zero
+std::vector<int> extendPath(int startNode, int selectCount, const DistanceMatrix& distance, const std::vector<int>& costs,
+                            std::vector<char>& selected, const NeighborRanking* ranking) {
     std::vector<int> solution;
-    std::vector<bool> selected(distance.size(), false);
-    
+    solution.reserve(selectCount);
     solution.push_back(startNode);
-    selected[startNode] = true;
+    selected[startNode] = 1;
     
-    while (solution.size() < selectCount) {
-        int lastNode = solution.back();
-        int bestNode = -1;
-        int bestDelta = INT_MAX;
-        
-        for (int i = 0; i < distance.size(); i++) {
-            if (selected[i]) continue;
-            int delta = distance[lastNode][i] + costs[i];
-            if (delta < bestDelta) {
-                bestDelta = delta;
-                bestNode = i;
-            }
-        }
-        
+    while ((int)solution.size() < selectCount) {
+        int bestNode = cheapestUnselected(solution.back(), selected, distance, costs, ranking);
         solution.push_back(bestNode);
-        selected[bestNode] = true;
+        selected[bestNode] = 1;
     }
     
+    for (int node : solution) selected[node] = 0;
     return solution;
 }
+
+}
+
+std::vector<int> nearestNeighborEnd(int startNode, int selectCount, const DistanceMatrix& distance, const std::vector<int>& costs,
+                                    const NeighborRanking* ranking) {
+    std::vector<char> selected(distance.size(), 0);
+    return extendPath(startNode, selectCount, distance, costs, selected, ranking);
+}
+BatchSolutions nearestNeighborEndBatch(const std::vector<int>& starts, int selectCount, const DistanceMatrix& distance,
+                                       const std::vector<int>& costs, const NeighborRanking& ranking, int threads) {
+    std::function<std::vector<char>()> makeWorkspace = [&]() { return std::vector<char>(distance.size(), 0); };
+    std::function<std::vector<int>(int, std::vector<char>&)> build = [&](int start, std::vector<char>& selected) {
+        return extendPath(start, selectCount, distance, costs, selected, &ranking);
+    };
+    return buildBatch(starts, batchThreads(distance, threads), makeWorkspace, build);
+}
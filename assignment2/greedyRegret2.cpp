@@ -1,52 +1,38 @@
 #include "../include/greedyRegret2.h"
+#include "../include/insertionCache.h"
 #include <climits>
 
-std::vector<int> greedyRegret2(int startNode, int selectCount, const std::vector<std::vector<int>>& distance, const std::vector<int>& costs) {
+std::vector<int> greedyRegret2(int startNode, int selectCount, const DistanceMatrix& distance, const std::vector<int>& costs,
+                               const NeighborRanking* ranking) {
     std::vector<int> solution;
     std::vector<bool> selected(distance.size(), false);
     solution.push_back(startNode);
     selected[startNode] = true;
     if (selectCount > 1) {
-        int bestNode = -1;
-        int bestDist = INT_MAX;
-        for (int i = 0; i < distance.size(); i++) {
-            if (selected[i]) continue;
-            int delta = distance[startNode][i] + costs[i];
-            if (delta < bestDist) { bestDist = delta; bestNode = i; }
-        }
+        int bestNode = cheapestUnselected(startNode, selected, distance, costs, ranking);
         solution.push_back(bestNode);
         selected[bestNode] = true;
     }
-    while (solution.size() < selectCount) {
+    // Best and second-best insertion of every unselected node, updated incrementally
+    InsertionCache cache(distance, costs);
+    cache.reset(solution);
+    while (cache.size() < selectCount) {
         int chooseNode = -1;
-        int choosePos = -1;
+        int chooseAfter = -1;
         int bestRegret = -1;
         int tieBestDelta = INT_MAX;
         for (int i = 0; i < distance.size(); i++) {
-            if (selected[i]) continue;
-            int best1 = INT_MAX, best2 = INT_MAX;
-            int bestPos = -1;
-            for (int pos = 0; pos < solution.size(); pos++) {
-                int next = (pos + 1) % solution.size();
-                int delta = distance[solution[pos]][i] + distance[i][solution[next]] - distance[solution[pos]][solution[next]] + costs[i];
-                if (delta < best1) {
-                    best2 = best1;
-                    best1 = delta;
-                    bestPos = pos + 1;
-                } else if (delta < best2) {
-                    best2 = delta;
-                }
-            }
+            if (cache.selected(i)) continue;
+            int best1 = cache.best1(i), best2 = cache.best2(i);
             int regret = (best2 == INT_MAX ? 0 : (best2 - best1));
             if (regret > bestRegret || (regret == bestRegret && best1 < tieBestDelta)) {
                 bestRegret = regret;
                 tieBestDelta = best1;
                 chooseNode = i;
-                choosePos = bestPos;
+                chooseAfter = cache.bestAfter(i);
             }
         }
-        solution.insert(solution.begin() + choosePos, chooseNode);
-        selected[chooseNode] = true;
+        cache.insertAfter(chooseNode, chooseAfter);
     }
-    return solution;
+    return cache.toVector();
 }
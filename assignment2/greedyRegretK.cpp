@@ -0,0 +1,142 @@
+#include "../include/greedyRegretK.h"
+#include "../include/constants.h"
+#include <climits>
+#include <algorithm>
+#include <cmath>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Distances from node to every tour node, at[m] = at[0] closing the cycle
+static void distancesToTour(int node, const std::vector<int>& solution, const DistanceMatrix& distance, std::vector<int32_t>& at) {
+    int m = solution.size();
+    int pos = 0;
+    if (distance.storage() == DistanceStorage::Full && distance.width() == DistanceWidth::Int16) {
+        const int16_t* row = distance.row16(node);
+#ifdef __AVX2__
+        // 32-bit gathers at 2-byte offsets keep the wanted entry in the low half; the
+        // last row is skipped so the gather never reads past the matrix
+        if (node + 1 < distance.size()) {
+            __m256i low = _mm256_set1_epi32(0xFFFF);
+            for (; pos + 8 <= m; pos += 8) {
+                __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(solution.data() + pos));
+                __m256i pair = _mm256_i32gather_epi32(reinterpret_cast<const int*>(row), index, 2);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(at.data() + pos), _mm256_and_si256(pair, low));
+            }
+        }
+#endif
+        for (; pos < m; pos++) at[pos] = row[solution[pos]];
+    } else if (distance.storage() == DistanceStorage::Full) {
+        const int32_t* row = distance.row32(node);
+#ifdef __AVX2__
+        for (; pos + 8 <= m; pos += 8) {
+            __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(solution.data() + pos));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(at.data() + pos), _mm256_i32gather_epi32(row, index, 4));
+        }
+#endif
+        for (; pos < m; pos++) at[pos] = row[solution[pos]];
+    } else {
+        DistanceMatrix::Row row = distance[node];
+        for (; pos < m; pos++) at[pos] = row[solution[pos]];
+    }
+    at[m] = at[0];
+}
+
+// The k smallest insertion deltas of one node over the m cycle edges, ascending,
+// in smallest[0..count); returns the insert position (pos + 1) of the first
+// cheapest edge, as the scans of the 2-regret constructors do.
+// edge[pos] is the length of (solution[pos], solution[pos + 1]).
+static int smallestDeltas(const int32_t* at, const int32_t* edge, int m, int cost, int k, int* smallest, int& count) {
+    int bestPos = -1;
+    count = 0;
+    auto offer = [&](int value, int pos) {
+        if (count == k && value >= smallest[k - 1]) return;
+        int j = count < k ? count++ : k - 1;
+        while (j > 0 && smallest[j - 1] > value) {
+            smallest[j] = smallest[j - 1];
+            j--;
+        }
+        smallest[j] = value;
+        if (j == 0) bestPos = pos + 1;
+    };
+    int pos = 0;
+#ifdef __AVX2__
+    // Eight deltas at a time against the current k-th smallest kept in a register;
+    // only lanes that beat it fall back to the scalar insertion, in position order
+    __m256i vcost = _mm256_set1_epi32(cost);
+    alignas(32) int32_t lanes[8];
+    for (; pos + 8 <= m; pos += 8) {
+        __m256i from = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(at + pos));
+        __m256i to = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(at + pos + 1));
+        __m256i length = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(edge + pos));
+        __m256i delta = _mm256_add_epi32(_mm256_sub_epi32(_mm256_add_epi32(from, to), length), vcost);
+        __m256i threshold = _mm256_set1_epi32(count == k ? smallest[k - 1] : INT_MAX);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(threshold, delta)));
+        if (mask == 0) continue;
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), delta);
+        for (; mask; mask &= mask - 1) {
+            int lane = __builtin_ctz(mask);
+            offer(lanes[lane], pos + lane);
+        }
+    }
+#endif
+    for (; pos < m; pos++) {
+        offer(at[pos] + at[pos + 1] - edge[pos] + cost, pos);
+    }
+    return bestPos;
+}
+
+std::vector<int> greedyRegretK(int startNode, int selectCount, const DistanceMatrix& distance, const std::vector<int>& costs, int k, double wRegret, double wBest) {
+    // The regret needs the cheapest insertion at least
+    k = std::max(k, 1);
+    std::vector<int> solution;
+    std::vector<bool> selected(distance.size(), false);
+    solution.push_back(startNode);
+    selected[startNode] = true;
+    if (selectCount > 1) {
+        int bestNode = -1;
+        int bestDist = INT_MAX;
+        for (int i = 0; i < distance.size(); i++) {
+            if (selected[i]) continue;
+            int delta = distance[startNode][i] + costs[i];
+            if (delta < bestDist) { bestDist = delta; bestNode = i; }
+        }
+        solution.push_back(bestNode);
+        selected[bestNode] = true;
+    }
+    
+    std::vector<int32_t> at(selectCount + 1), edge(selectCount);
+    std::vector<int> smallest(k);
+    while ((int)solution.size() < selectCount) {
+        int m = solution.size();
+        for (int pos = 0; pos < m; pos++) {
+            edge[pos] = distance[solution[pos]][solution[pos + 1 == m ? 0 : pos + 1]];
+        }
+        
+        int chooseNode = -1;
+        int choosePos = -1;
+        double bestScore = INIT_SCORE;
+        int tieBestDelta = INT_MAX;
+        int tieBestRegret = -1;
+        for (int i = 0; i < distance.size(); i++) {
+            if (selected[i]) continue;
+            distancesToTour(i, solution, distance, at);
+            int count;
+            int bestPos = smallestDeltas(at.data(), edge.data(), m, costs[i], k, smallest.data(), count);
+            int best1 = smallest[0];
+            int regret = 0;
+            for (int j = 1; j < count; j++) regret += smallest[j] - best1;
+            double score = wRegret * regret - wBest * best1;
+            if (score > bestScore || (std::abs(score - bestScore) < EPSILON && (best1 < tieBestDelta || (best1 == tieBestDelta && regret > tieBestRegret)))) {
+                bestScore = score;
+                tieBestDelta = best1;
+                tieBestRegret = regret;
+                chooseNode = i;
+                choosePos = bestPos;
+            }
+        }
+        solution.insert(solution.begin() + choosePos, chooseNode);
+        selected[chooseNode] = true;
+    }
+    return solution;
+}
@@ -1,59 +1,27 @@
 #include "../include/nearestNeighborAnyRegret2Weighted.h"
-#include "../include/constants.h"
-#include <climits>
-#include <cmath>
+#include "../include/insertionCache.h"
+#include "../include/regretQueue.h"
 
-std::vector<int> nearestNeighborAnyRegret2Weighted(int startNode, int selectCount, const std::vector<std::vector<int>>& distance, const std::vector<int>& costs, double wRegret, double wBest) {
+std::vector<int> nearestNeighborAnyRegret2Weighted(int startNode, int selectCount, const DistanceMatrix& distance, const std::vector<int>& costs, double wRegret, double wBest) {
     std::vector<int> solution;
-    std::vector<bool> selected(distance.size(), false);
     solution.push_back(startNode);
-    selected[startNode] = true;
     
-    while (solution.size() < selectCount) {
-        int chooseNode = -1;
-        int choosePos = -1;
-        double bestScore = INIT_SCORE;
-        int tieBestDelta = INT_MAX;
-        int tieBestRegret = -1;
-        
-        for (int i = 0; i < distance.size(); i++) {
-            if (selected[i]) continue;
-            int best1 = INT_MAX, best2 = INT_MAX;
-            int bestPos = -1;
-            
-            for (int pos = 0; pos <= solution.size(); pos++) {
-                int delta = costs[i];
-                if (pos == 0) {
-                    delta += distance[i][solution[0]];
-                } else if (pos == solution.size()) {
-                    delta += distance[solution.back()][i];
-                } else {
-                    delta += distance[solution[pos-1]][i] + distance[i][solution[pos]] - distance[solution[pos-1]][solution[pos]];
-                }
-                
-                if (delta < best1) {
-                    best2 = best1;
-                    best1 = delta;
-                    bestPos = pos;
-                } else if (delta < best2) {
-                    best2 = delta;
-                }
-            }
-            
-            int regret = (best2 == INT_MAX ? 0 : (best2 - best1));
-            double score = wRegret * regret - wBest * best1;
-            if (score > bestScore || (std::abs(score - bestScore) < EPSILON && (best1 < tieBestDelta || (best1 == tieBestDelta && regret > tieBestRegret)))) {
-                bestScore = score;
-                tieBestDelta = best1;
-                tieBestRegret = regret;
-                chooseNode = i;
-                choosePos = bestPos;
-            }
+    // Best and second-best insertion into the path for every unselected node, updated
+    // incrementally, and the unselected nodes ordered by weighted regret
+    InsertionCache cache(distance, costs, TourShape::Path);
+    cache.reset(solution);
+    RegretQueue queue(distance.size(), wRegret, wBest);
+    for (int i = 0; i < distance.size(); i++) {
+        if (!cache.selected(i)) queue.update(i, cache.best1(i), cache.best2(i));
+    }
+    while (cache.size() < selectCount) {
+        int chooseNode = queue.top();
+        queue.remove(chooseNode);
+        cache.insertAfter(chooseNode, cache.bestAfter(chooseNode));
+        for (int i : cache.changed()) {
+            queue.update(i, cache.best1(i), cache.best2(i));
         }
-        
-        solution.insert(solution.begin() + choosePos, chooseNode);
-        selected[chooseNode] = true;
     }
     
-    return solution;
+    return cache.toVector();
 }
@@ -0,0 +1,240 @@
+#include "../include/localSearch.h"
+#include "../include/candidateMoves.h"
+#include "../include/twoLevelTour.h"
+#include "../include/localSearchCounters.h"
+#include <algorithm>
+
+namespace {
+
+// From this tour size on, 2-opt reversals go through a TwoLevelTour; below it
+// the neighbour-list moves are short enough for plain array reversals to win
+constexpr int TWO_LEVEL_MIN_TOUR = 10000;
+
+// Tour in a plain array with a position index, both kept in the workspace;
+// the 2-opt reverses the shorter side of the cycle in O(m). Same interface as
+// TwoLevelTour.
+class ArrayTour {
+public:
+    ArrayTour(int n, LSWorkspace& workspace) : sol(workspace.tour), pos(workspace.position) {
+        pos.assign(n, -1);
+    }
+
+    void reset(const std::vector<int>& nodes) {
+        sol = nodes;
+        for (int i = 0; i < size(); i++) pos[sol[i]] = i;
+    }
+
+    int size() const { return sol.size(); }
+    bool contains(int node) const { return pos[node] >= 0; }
+    int next(int node) const { return sol[pos[node] + 1 == size() ? 0 : pos[node] + 1]; }
+    int prev(int node) const { return sol[pos[node] == 0 ? size() - 1 : pos[node] - 1]; }
+
+    // Remove edges (a, next(a)) and (c, next(c)), add (a, c) and (next(a), next(c))
+    void twoOptMove(int a, int c) {
+        int m = size();
+        int i = pos[a], j = pos[c];
+        if (i > j) std::swap(i, j);
+        int from = i + 1, length = j - i;
+        if (2 * length > m) {
+            from = j + 1;
+            length = m - length;
+        }
+        for (int p = 0, q = length - 1; p < q; p++, q--) {
+            int x = (from + p) % m, y = (from + q) % m;
+            std::swap(sol[x], sol[y]);
+            pos[sol[x]] = x;
+            pos[sol[y]] = y;
+        }
+    }
+
+    void replace(int oldNode, int newNode) {
+        int index = pos[oldNode];
+        sol[index] = newNode;
+        pos[newNode] = index;
+        pos[oldNode] = -1;
+    }
+
+    void toVector(std::vector<int>& nodes) const { nodes = sol; }
+
+private:
+    std::vector<int>& sol;
+    std::vector<int>& pos;   // position in sol, -1 if not selected
+};
+
+enum class MoveType { None, TwoOpt, Exchange };
+
+struct Move {
+    MoveType type = MoveType::None;
+    int delta = 0;
+    int a = 0, b = 0;   // TwoOpt: the edges leaving a and b are exchanged; Exchange: b replaces a
+};
+
+// Runs on tour, which holds the initial solution, and leaves the result in workspace.solution
+template <class Tour>
+void dontLookBits(
+    Tour& tour,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    const std::vector<std::vector<int>>& neighbors,
+    LSWorkspace& workspace
+) {
+    if (tour.size() < 4) return;
+
+    // Nodes whose don't-look bit is off, in FIFO order (every selected node at the start)
+    std::vector<int>& queue = workspace.queue;
+    queue.assign(workspace.solution.begin(), workspace.solution.end());
+    std::vector<bool>& queued = workspace.queued;
+    queued.assign(n, false);
+    for (int node : queue) queued[node] = true;
+    size_t head = 0;
+    auto wake = [&](int node) {
+        if (!tour.contains(node) || queued[node]) return;
+        queued[node] = true;
+        queue.push_back(node);
+    };
+
+    long long evaluated = 0, checks = 0, intraMoves = 0, exchangeMoves = 0;
+    while (head < queue.size()) {
+        int u = queue[head++];
+        queued[u] = false;
+        if (head > (size_t)n && 2 * head > queue.size()) {
+            queue.erase(queue.begin(), queue.begin() + head);
+            head = 0;
+        }
+        if (!tour.contains(u)) continue;
+
+        // Best move that creates an edge from u to one of its neighbours
+        int nextU = tour.next(u), prevU = tour.prev(u);
+        Move best;
+        checks += neighbors[u].size();
+        for (int v : neighbors[u]) {
+            if (tour.contains(v)) {
+                if (v == nextU || v == prevU) continue;
+                int nextV = tour.next(v), prevV = tour.prev(v);
+                evaluated += 2;
+                // (u, nextU), (v, nextV) -> (u, v), (nextU, nextV)
+                int delta = distance[u][v] + distance[nextU][nextV] - distance[u][nextU] - distance[v][nextV];
+                if (delta < best.delta) best = {MoveType::TwoOpt, delta, u, v};
+                // (prevU, u), (prevV, v) -> (u, v), (prevU, prevV)
+                delta = distance[u][v] + distance[prevU][prevV] - distance[prevU][u] - distance[prevV][v];
+                if (delta < best.delta) best = {MoveType::TwoOpt, delta, prevU, prevV};
+            } else {
+                // v replaces the successor of u: (u, w), (w, x) -> (u, v), (v, x)
+                int w = nextU, x = tour.next(nextU);
+                evaluated += 2;
+                int delta = distance[u][v] + distance[v][x] - distance[u][w] - distance[w][x] + costs[v] - costs[w];
+                if (delta < best.delta) best = {MoveType::Exchange, delta, w, v};
+                // v replaces the predecessor of u: (x, w), (w, u) -> (x, v), (v, u)
+                w = prevU, x = tour.prev(prevU);
+                delta = distance[x][v] + distance[v][u] - distance[x][w] - distance[w][u] + costs[v] - costs[w];
+                if (delta < best.delta) best = {MoveType::Exchange, delta, w, v};
+            }
+        }
+
+        // No improving move: leave u's don't-look bit on until a neighbouring edge changes
+        if (best.type == MoveType::None) continue;
+
+        // Wake the endpoints of every removed and added edge
+        int touched[4];
+        int touchedCount;
+        if (best.type == MoveType::TwoOpt) {
+            touched[0] = best.a;
+            touched[1] = tour.next(best.a);
+            touched[2] = best.b;
+            touched[3] = tour.next(best.b);
+            touchedCount = 4;
+            tour.twoOptMove(best.a, best.b);
+            intraMoves++;
+        } else {
+            touched[0] = tour.prev(best.a);
+            touched[1] = tour.next(best.a);
+            touched[2] = best.b;
+            touchedCount = 3;
+            tour.replace(best.a, best.b);
+            exchangeMoves++;
+        }
+        for (int t = 0; t < touchedCount; t++) wake(touched[t]);
+    }
+
+    LS_COUNT(deltaEvaluations, evaluated);
+    LS_COUNT(candidateChecks, checks);
+    LS_COUNT(improvingMoves, intraMoves + exchangeMoves);
+    LS_COUNT(intraApplied, intraMoves);
+    LS_COUNT(exchangeApplied, exchangeMoves);
+    tour.toVector(workspace.solution);
+}
+
+}
+
+const std::vector<int>& localSearchDontLookBits(
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    const std::vector<std::vector<int>>& neighbors,
+    LSWorkspace& workspace
+) {
+    workspace.start(initialSolution, n);
+    if ((int)initialSolution.size() >= TWO_LEVEL_MIN_TOUR) {
+        TwoLevelTour& tour = workspace.twoLevelTour;
+        tour.resize(n);
+        tour.reset(workspace.solution);
+        dontLookBits(tour, distance, costs, n, neighbors, workspace);
+    } else {
+        ArrayTour tour(n, workspace);
+        tour.reset(workspace.solution);
+        dontLookBits(tour, distance, costs, n, neighbors, workspace);
+    }
+    return workspace.solution;
+}
+
+std::vector<int> localSearchDontLookBits(
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    const std::vector<std::vector<int>>& neighbors
+) {
+    LSWorkspace workspace;
+    localSearchDontLookBits(initialSolution, distance, costs, n, neighbors, workspace);
+    return std::move(workspace.solution);
+}
+
+std::vector<int> localSearchDontLookBits(
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    int k
+) {
+    return localSearchDontLookBits(initialSolution, distance, costs, n, buildNearestNeighbors(n, distance, costs, k));
+}
+
+const std::vector<int>& runLocalSearch(
+    LocalSearchKind kind,
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    const std::vector<std::vector<int>>& neighbors,
+    LSWorkspace& workspace
+) {
+    if (kind == LocalSearchKind::DontLookBits) {
+        return localSearchDontLookBits(initialSolution, distance, costs, n, neighbors, workspace);
+    }
+    return localSearchSteepestEdges(initialSolution, distance, costs, n, workspace);
+}
+
+std::vector<int> runLocalSearch(
+    LocalSearchKind kind,
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    const std::vector<std::vector<int>>& neighbors
+) {
+    LSWorkspace workspace;
+    runLocalSearch(kind, initialSolution, distance, costs, n, neighbors, workspace);
+    return std::move(workspace.solution);
+}
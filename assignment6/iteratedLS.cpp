@@ -1,20 +1,28 @@
 #include "../include/iteratedLS.h"
 #include "../include/localSearch.h"
+#include "../include/candidateMoves.h"
 #include "../include/calculateObjective.h"
 #include <chrono>
 #include <climits>
 #include <algorithm>
 
+ILSWorkspace::ILSWorkspace(int n) : search(n) {
+    perturbed.reserve(n);
+    inSolution.reserve(n);
+    notSelected.reserve(n);
+}
+
 // Perturbation function: performs multiple random edge exchanges to escape local optimum
 // This destroys enough structure to escape but preserves quality better than random restart
-std::vector<int> perturbSolution(
+// The result is left in workspace.perturbed
+static void perturbSolution(
     const std::vector<int>& solution,
-    const std::vector<std::vector<int>>& distance,
-    const std::vector<int>& costs,
     int n,
-    std::mt19937& rng
+    std::mt19937& rng,
+    ILSWorkspace& workspace
 ) {
-    std::vector<int> perturbed = solution;
+    std::vector<int>& perturbed = workspace.perturbed;
+    perturbed = solution;
     int solSize = perturbed.size();
     
     // Perturbation strength: perform k random 2-opt moves
@@ -42,10 +50,12 @@ std::vector<int> perturbSolution(
     std::uniform_real_distribution<> probDist(0.0, 1.0);
     if (probDist(rng) < 0.3) {
         // Build set of nodes not in solution
-        std::vector<bool> inSolution(n, false);
+        std::vector<bool>& inSolution = workspace.inSolution;
+        inSolution.assign(n, false);
         for (int node : perturbed) inSolution[node] = true;
         
-        std::vector<int> notSelected;
+        std::vector<int>& notSelected = workspace.notSelected;
+        notSelected.clear();
         for (int i = 0; i < n; i++) {
             if (!inSolution[i]) notSelected.push_back(i);
         }
@@ -60,18 +70,31 @@ std::vector<int> perturbSolution(
             perturbed[replacePos] = newNode;
         }
     }
-    
-    return perturbed;
+}
+
+const std::vector<int>& iteratedLSStep(
+    const std::vector<int>& current,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    const std::vector<std::vector<int>>& neighbors,
+    LocalSearchKind localSearch,
+    std::mt19937& rng,
+    ILSWorkspace& workspace
+) {
+    perturbSolution(current, n, rng, workspace);
+    return runLocalSearch(localSearch, workspace.perturbed, distance, costs, n, neighbors, workspace.search);
 }
 
 ILSResult iteratedLS(
     int n,
     int selectCount,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     const std::vector<std::vector<int>>& randomInitials,
     double timeLimit,
-    std::mt19937& rng
+    std::mt19937& rng,
+    LocalSearchKind localSearch
 ) {
     ILSResult result;
     result.bestObjective = INT_MAX;
@@ -79,11 +102,20 @@ ILSResult iteratedLS(
     
     auto startTime = std::chrono::high_resolution_clock::now();
     
+    // Neighbour lists are built once per run, inside the time budget
+    std::vector<std::vector<int>> neighbors;
+    if (localSearch == LocalSearchKind::DontLookBits) {
+        neighbors = buildNearestNeighbors(n, distance, costs, DONT_LOOK_NEIGHBORS);
+    }
+    
+    // Perturbation and local search buffers shared by all iterations
+    ILSWorkspace workspace(n);
+    
     // Use first pre-generated random solution as initial solution
     std::vector<int> current = randomInitials[0];
     
     // Apply local search to initial solution
-    current = localSearchSteepestEdges(current, distance, costs, n);
+    current = runLocalSearch(localSearch, current, distance, costs, n, neighbors, workspace.search);
     result.lsRuns++;
     
     int currentObj = calculateObjective(current, distance, costs);
@@ -97,11 +129,8 @@ ILSResult iteratedLS(
         double elapsed = std::chrono::duration<double, std::milli>(currentTime - startTime).count();
         if (elapsed >= timeLimit) break;
         
-        // Perturbation
-        std::vector<int> perturbed = perturbSolution(current, distance, costs, n, rng);
-        
-        // Local search on perturbed solution
-        std::vector<int> improved = localSearchSteepestEdges(perturbed, distance, costs, n);
+        // Perturbation and local search on the perturbed solution
+        const std::vector<int>& improved = iteratedLSStep(current, distance, costs, n, neighbors, localSearch, rng, workspace);
         result.lsRuns++;
         
         int improvedObj = calculateObjective(improved, distance, costs);
@@ -7,7 +7,7 @@
 MSLSResult multipleStartLS(
     int n,
     int selectCount,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     const std::vector<std::vector<int>>& randomInitials,
     int iterations,
@@ -19,12 +19,15 @@ MSLSResult multipleStartLS(
     
     auto startTime = std::chrono::high_resolution_clock::now();
     
+    // Local search buffers shared by all iterations
+    LSWorkspace workspace(n);
+    
     for (int iter = 0; iter < iterations; iter++) {
         // Use pre-generated random starting solution (cycling through if iterations > n)
-        std::vector<int> initial = randomInitials[iter % n];
+        const std::vector<int>& initial = randomInitials[iter % n];
         
         // Apply steepest local search with edges exchange
-        std::vector<int> solution = localSearchSteepestEdges(initial, distance, costs, n);
+        const std::vector<int>& solution = localSearchSteepestEdges(initial, distance, costs, n, workspace);
         
         // Evaluate solution
         int objective = calculateObjective(solution, distance, costs);
@@ -1,27 +1,39 @@
 #include "../include/largeNeighborhoodSearch.h"
 #include "../include/localSearch.h"
+#include "../include/candidateMoves.h"
 #include "../include/calculateObjective.h"
+#include "../include/insertionCache.h"
 #include <chrono>
 #include <climits>
 #include <algorithm>
-#include <numeric>
 #include <cmath>
 
+LNSWorkspace::LNSWorkspace(const DistanceMatrix& distance, const std::vector<int>& costs, int n)
+    : search(n), repair(distance, costs) {
+    weights.reserve(n);
+    removed.reserve(n);
+    inSolution.reserve(n);
+    partial.reserve(n);
+    repaired.reserve(n);
+}
+
 // Destroy operator: removes a fraction of nodes from the solution
 // Uses weighted random removal - nodes connected by longer edges have higher probability of removal
-std::vector<int> destroySolution(
+// The remaining nodes are left in workspace.partial
+static void destroySolution(
     const std::vector<int>& solution,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
-    int n,
     double destroyFraction,
-    std::mt19937& rng
+    std::mt19937& rng,
+    LNSWorkspace& workspace
 ) {
     int solSize = solution.size();
     int numToRemove = std::max(1, static_cast<int>(solSize * destroyFraction));
     
     // Calculate weights based on edge costs (longer edges = higher weight for adjacent nodes)
-    std::vector<double> weights(solSize);
+    std::vector<double>& weights = workspace.weights;
+    weights.resize(solSize);
     for (int i = 0; i < solSize; i++) {
         int prev = (i - 1 + solSize) % solSize;
         int next = (i + 1) % solSize;
@@ -31,9 +43,8 @@ std::vector<int> destroySolution(
     }
     
     // Select nodes to remove using weighted random selection
-    std::vector<bool> toRemove(solSize, false);
-    std::vector<int> indices(solSize);
-    std::iota(indices.begin(), indices.end(), 0);
+    std::vector<bool>& toRemove = workspace.removed;
+    toRemove.assign(solSize, false);
     
     for (int removed = 0; removed < numToRemove; removed++) {
         // Calculate sum of weights for non-removed nodes
@@ -58,31 +69,32 @@ std::vector<int> destroySolution(
     }
     
     // Build remaining solution (preserving order)
-    std::vector<int> remaining;
+    std::vector<int>& remaining = workspace.partial;
+    remaining.clear();
     for (int i = 0; i < solSize; i++) {
         if (!toRemove[i]) {
             remaining.push_back(solution[i]);
         }
     }
-    
-    return remaining;
 }
 
-// Repair operator: rebuilds solution to full size using greedy insertion
+// Repair operator: rebuilds workspace.partial to full size using greedy insertion
 // Uses weighted 2-regret heuristic (best performing greedy heuristic)
-std::vector<int> repairSolution(
-    const std::vector<int>& partial,
-    const std::vector<std::vector<int>>& distance,
+// The result is left in workspace.repaired
+static void repairSolution(
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     int n,
     int selectCount,
     double wRegret,
-    double wBest
+    double wBest,
+    LNSWorkspace& workspace
 ) {
-    std::vector<int> solution = partial;
+    std::vector<int>& solution = workspace.partial;
     
     // Mark nodes already in solution
-    std::vector<bool> selected(n, false);
+    std::vector<bool>& selected = workspace.inSolution;
+    selected.assign(n, false);
     for (int node : solution) {
         selected[node] = true;
     }
@@ -123,36 +135,23 @@ std::vector<int> repairSolution(
         }
     }
     
-    // Use weighted 2-regret to insert remaining nodes
+    // Use weighted 2-regret to insert remaining nodes, with incrementally updated insertion costs
     const double EPSILON = 1e-9;
     const double INIT_SCORE = -1e18;
     
-    while (solution.size() < selectCount) {
+    InsertionCache& cache = workspace.repair;
+    cache.reset(solution);
+    while (cache.size() < selectCount) {
         int chooseNode = -1;
-        int choosePos = -1;
+        int chooseAfter = -1;
         double bestScore = INIT_SCORE;
         int tieBestDelta = INT_MAX;
         int tieBestRegret = -1;
         
         for (int i = 0; i < n; i++) {
-            if (selected[i]) continue;
+            if (cache.selected(i)) continue;
             
-            int best1 = INT_MAX, best2 = INT_MAX;
-            int bestPos = -1;
-            
-            for (int pos = 0; pos < solution.size(); pos++) {
-                int next = (pos + 1) % solution.size();
-                int delta = distance[solution[pos]][i] + distance[i][solution[next]] 
-                           - distance[solution[pos]][solution[next]] + costs[i];
-                
-                if (delta < best1) {
-                    best2 = best1;
-                    best1 = delta;
-                    bestPos = pos + 1;
-                } else if (delta < best2) {
-                    best2 = delta;
-                }
-            }
+            int best1 = cache.best1(i), best2 = cache.best2(i);
             
             int regret = (best2 == INT_MAX ? 0 : (best2 - best1));
             double score = wRegret * regret - wBest * best1;
@@ -164,29 +163,51 @@ std::vector<int> repairSolution(
                 tieBestDelta = best1;
                 tieBestRegret = regret;
                 chooseNode = i;
-                choosePos = bestPos;
+                chooseAfter = cache.bestAfter(i);
             }
         }
         
         if (chooseNode == -1) break;  // No valid node found
         
-        solution.insert(solution.begin() + choosePos, chooseNode);
-        selected[chooseNode] = true;
+        cache.insertAfter(chooseNode, chooseAfter);
     }
     
-    return solution;
+    cache.toVector(workspace.repaired);
+}
+
+const std::vector<int>& largeNeighborhoodSearchStep(
+    const std::vector<int>& current,
+    int n,
+    int selectCount,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    double destroyFraction,
+    bool withLocalSearch,
+    LocalSearchKind localSearch,
+    const std::vector<std::vector<int>>& neighbors,
+    std::mt19937& rng,
+    LNSWorkspace& workspace
+) {
+    // Repair parameters (weighted 2-regret)
+    double wRegret = 1.0, wBest = 1.0;
+    
+    destroySolution(current, distance, costs, destroyFraction, rng, workspace);
+    repairSolution(distance, costs, n, selectCount, wRegret, wBest, workspace);
+    if (!withLocalSearch) return workspace.repaired;
+    return runLocalSearch(localSearch, workspace.repaired, distance, costs, n, neighbors, workspace.search);
 }
 
 // LNS with local search after destroy-repair
 LNSResult largeNeighborhoodSearchWithLS(
     int n,
     int selectCount,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     const std::vector<std::vector<int>>& randomInitials,
     double timeLimit,
     std::mt19937& rng,
-    double destroyFraction
+    double destroyFraction,
+    LocalSearchKind localSearch
 ) {
     LNSResult result;
     result.bestObjective = INT_MAX;
@@ -194,19 +215,25 @@ LNSResult largeNeighborhoodSearchWithLS(
     
     auto startTime = std::chrono::high_resolution_clock::now();
     
+    // Neighbour lists are built once per run, inside the time budget
+    std::vector<std::vector<int>> neighbors;
+    if (localSearch == LocalSearchKind::DontLookBits) {
+        neighbors = buildNearestNeighbors(n, distance, costs, DONT_LOOK_NEIGHBORS);
+    }
+    
+    // Destroy, repair and local search buffers shared by all iterations
+    LNSWorkspace workspace(distance, costs, n);
+    
     // Initialize with random solution
     std::vector<int> current = randomInitials[0];
     
     // Apply local search to initial solution (always)
-    current = localSearchSteepestEdges(current, distance, costs, n);
+    current = runLocalSearch(localSearch, current, distance, costs, n, neighbors, workspace.search);
     
     int currentObj = calculateObjective(current, distance, costs);
     result.bestObjective = currentObj;
     result.bestSolution = current;
     
-    // Repair parameters (weighted 2-regret)
-    double wRegret = 1.0, wBest = 1.0;
-    
     // Main LNS loop
     while (true) {
         auto currentTime = std::chrono::high_resolution_clock::now();
@@ -215,14 +242,9 @@ LNSResult largeNeighborhoodSearchWithLS(
         
         result.iterations++;
         
-        // Destroy
-        std::vector<int> destroyed = destroySolution(current, distance, costs, n, destroyFraction, rng);
-        
-        // Repair
-        std::vector<int> repaired = repairSolution(destroyed, distance, costs, n, selectCount, wRegret, wBest);
-        
-        // Local search
-        std::vector<int> improved = localSearchSteepestEdges(repaired, distance, costs, n);
+        // Destroy, repair and local search
+        const std::vector<int>& improved = largeNeighborhoodSearchStep(current, n, selectCount, distance, costs,
+            destroyFraction, true, localSearch, neighbors, rng, workspace);
         
         int improvedObj = calculateObjective(improved, distance, costs);
         
@@ -249,12 +271,13 @@ LNSResult largeNeighborhoodSearchWithLS(
 LNSResult largeNeighborhoodSearchNoLS(
     int n,
     int selectCount,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     const std::vector<std::vector<int>>& randomInitials,
     double timeLimit,
     std::mt19937& rng,
-    double destroyFraction
+    double destroyFraction,
+    LocalSearchKind localSearch
 ) {
     LNSResult result;
     result.bestObjective = INT_MAX;
@@ -262,19 +285,25 @@ LNSResult largeNeighborhoodSearchNoLS(
     
     auto startTime = std::chrono::high_resolution_clock::now();
     
+    // Neighbour lists are built once per run, inside the time budget
+    std::vector<std::vector<int>> neighbors;
+    if (localSearch == LocalSearchKind::DontLookBits) {
+        neighbors = buildNearestNeighbors(n, distance, costs, DONT_LOOK_NEIGHBORS);
+    }
+    
+    // Destroy, repair and local search buffers shared by all iterations
+    LNSWorkspace workspace(distance, costs, n);
+    
     // Initialize with random solution
     std::vector<int> current = randomInitials[0];
     
     // Apply local search to initial solution (always, as per spec)
-    current = localSearchSteepestEdges(current, distance, costs, n);
+    current = runLocalSearch(localSearch, current, distance, costs, n, neighbors, workspace.search);
     
     int currentObj = calculateObjective(current, distance, costs);
     result.bestObjective = currentObj;
     result.bestSolution = current;
     
-    // Repair parameters (weighted 2-regret)
-    double wRegret = 1.0, wBest = 1.0;
-    
     // Main LNS loop
     while (true) {
         auto currentTime = std::chrono::high_resolution_clock::now();
@@ -283,11 +312,9 @@ LNSResult largeNeighborhoodSearchNoLS(
         
         result.iterations++;
         
-        // Destroy
-        std::vector<int> destroyed = destroySolution(current, distance, costs, n, destroyFraction, rng);
-        
-        // Repair (no local search)
-        std::vector<int> repaired = repairSolution(destroyed, distance, costs, n, selectCount, wRegret, wBest);
+        // Destroy and repair (no local search)
+        const std::vector<int>& repaired = largeNeighborhoodSearchStep(current, n, selectCount, distance, costs,
+            destroyFraction, false, localSearch, neighbors, rng, workspace);
         
         int repairedObj = calculateObjective(repaired, distance, costs);
         
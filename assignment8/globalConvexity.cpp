@@ -76,7 +76,7 @@ GlobalConvexityResult analyzeGlobalConvexity(
     const std::string& instanceName,
     int n,
     int selectCount,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     const std::vector<int>& bestSolutionFromBestMethod,
     std::mt19937& rng
@@ -0,0 +1,40 @@
+# Usage: ./benchmark.sh <name> [args]   (builds and runs benchmarks/<name>Benchmark.cpp)
+name=$1
+shift
+g++ -std=c++17 -O2 -march=native -pthread -I. $CXXFLAGS \
+    benchmarks/${name}Benchmark.cpp \
+    calculateObjective.cpp \
+    insertionCache.cpp \
+    edgeGrid.cpp \
+    constructionBatch.cpp \
+    neighborRanking.cpp \
+    linkedTour.cpp \
+    twoLevelTour.cpp \
+    regretQueue.cpp \
+    minTree.cpp \
+    exchangeScan.cpp \
+    randomMoveOrder.cpp \
+    localSearchWorkspace.cpp \
+    localSearchCounters.cpp \
+    workerPool.cpp \
+    distanceMatrix.cpp \
+    mappedFile.cpp \
+    instance.cpp \
+    assignment1/randomSolution.cpp \
+    assignment1/nearestNeighborEnd.cpp \
+    assignment1/nearestNeighborAny.cpp \
+    assignment1/greedyCycle.cpp \
+    assignment2/greedyRegret2.cpp \
+    assignment2/greedyRegret2Weighted.cpp \
+    assignment2/greedyRegretK.cpp \
+    assignment2/nearestNeighborAnyRegret2.cpp \
+    assignment2/nearestNeighborAnyRegret2Weighted.cpp \
+    assignment3/localSearch.cpp \
+    assignment4/candidateMoves.cpp \
+    assignment4/localSearchDontLookBits.cpp \
+    assignment5/localSearchLM.cpp \
+    assignment5/localSearchLMCandidates.cpp \
+    assignment6/multipleStartLS.cpp \
+    assignment6/iteratedLS.cpp \
+    assignment7/largeNeighborhoodSearch.cpp \
+    -o benchmarks/${name}Benchmark && ./benchmarks/${name}Benchmark "$@"
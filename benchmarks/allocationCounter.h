@@ -0,0 +1,51 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+// Replaces the global operator new/delete to count allocations and track live
+// and peak heap bytes. Include from exactly one translation unit (the benchmark
+// with main()); single-threaded use only.
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+namespace allocationCounter {
+
+inline size_t allocations = 0;
+inline size_t liveBytes = 0;
+inline size_t peakBytes = 0;
+
+// Start a new measurement: the peak is relative to what is live now
+inline void resetPeak() {
+    peakBytes = liveBytes;
+}
+
+// Every block is prefixed with its size, padded to keep max_align_t alignment
+constexpr size_t HEADER = alignof(std::max_align_t);
+
+inline void* allocate(size_t size) {
+    void* block = std::malloc(size + HEADER);
+    if (!block) throw std::bad_alloc();
+    *static_cast<size_t*>(block) = size;
+    allocations++;
+    liveBytes += size;
+    if (liveBytes > peakBytes) peakBytes = liveBytes;
+    return static_cast<char*>(block) + HEADER;
+}
+
+inline void release(void* pointer) {
+    if (!pointer) return;
+    void* block = static_cast<char*>(pointer) - HEADER;
+    liveBytes -= *static_cast<size_t*>(block);
+    std::free(block);
+}
+
+}
+
+void* operator new(size_t size) { return allocationCounter::allocate(size); }
+void* operator new[](size_t size) { return allocationCounter::allocate(size); }
+void operator delete(void* pointer) noexcept { allocationCounter::release(pointer); }
+void operator delete[](void* pointer) noexcept { allocationCounter::release(pointer); }
+void operator delete(void* pointer, size_t) noexcept { allocationCounter::release(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { allocationCounter::release(pointer); }
+
+#endif
@@ -0,0 +1,114 @@
+// Full multi-start sweep (every node as a start) built one call per start versus
+// the batch constructors, single-threaded and across threads. Checks that the
+// batch returns the same solutions in the same order.
+//
+// Usage: ./benchmark.sh batchConstruction [csv ...] [--threads=T]
+//   defaults: input/TSPA.csv input/TSPB.csv, T = hardware threads
+// Exits with status 1 if any solution differs.
+#include "../include/instance.h"
+#include "../include/constructionBatch.h"
+#include "../include/nearestNeighborEnd.h"
+#include "../include/greedyCycle.h"
+#include "../include/greedyRegret2Weighted.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <functional>
+#include <chrono>
+#include <thread>
+
+using Single = std::function<std::vector<int>(int, int, const DistanceMatrix&, const std::vector<int>&)>;
+using Batch = std::function<BatchSolutions(const std::vector<int>&, int, const DistanceMatrix&, const std::vector<int>&, int)>;
+
+struct Constructor {
+    std::string name;
+    Single single;
+    Batch batch;
+};
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+}
+
+// Wall time of the whole sweep per variant; returns the number of differing solutions
+static int sweep(const Constructor& constructor, const Instance& instance, int threads) {
+    int n = instance.size();
+    int selectCount = (n + 1) / 2;
+    std::vector<int> starts = allStarts(n);
+
+    auto begin = std::chrono::high_resolution_clock::now();
+    std::vector<std::vector<int>> expected;
+    for (int start : starts) expected.push_back(constructor.single(start, selectCount, instance.distance, instance.costs));
+    double singleMs = elapsedMs(begin);
+
+    begin = std::chrono::high_resolution_clock::now();
+    BatchSolutions serial = constructor.batch(starts, selectCount, instance.distance, instance.costs, 1);
+    double serialMs = elapsedMs(begin);
+
+    begin = std::chrono::high_resolution_clock::now();
+    BatchSolutions parallel = constructor.batch(starts, selectCount, instance.distance, instance.costs, threads);
+    double parallelMs = elapsedMs(begin);
+
+    int mismatches = 0;
+    for (int i = 0; i < n; i++) {
+        if (serial.solutions[i] != expected[i] || parallel.solutions[i] != expected[i]) mismatches++;
+    }
+    std::cout << "  " << std::left << std::setw(22) << constructor.name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << singleMs << std::setw(12) << serialMs << std::setw(12) << parallelMs
+              << std::setprecision(1) << std::setw(9) << singleMs / parallelMs << "x"
+              << (mismatches ? "  MISMATCH in " + std::to_string(mismatches) + " solutions" : "  identical") << "\n";
+    return mismatches;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> files;
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--threads=", 0) == 0) {
+            threads = std::stoi(arg.substr(10));
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) files = {"input/TSPA.csv", "input/TSPB.csv"};
+
+    std::vector<Constructor> constructors = {
+        {"Nearest Neighbor End", [](int start, int k, const DistanceMatrix& d, const std::vector<int>& c) {
+            return nearestNeighborEnd(start, k, d, c);
+        }, [](const std::vector<int>& starts, int k, const DistanceMatrix& d, const std::vector<int>& c, int t) {
+            // The sweep is timed with the ranking build, like a per-call run that has none
+            NeighborRanking ranking(d, c);
+            return nearestNeighborEndBatch(starts, k, d, c, ranking, t);
+        }},
+        {"Greedy Cycle", [](int start, int k, const DistanceMatrix& d, const std::vector<int>& c) {
+            return greedyCycle(start, k, d, c);
+        }, greedyCycleBatch},
+        // Any constructor can be batched through buildBatch, without a shared workspace
+        {"Greedy Weighted", [](int start, int k, const DistanceMatrix& d, const std::vector<int>& c) {
+            return greedyRegret2Weighted(start, k, d, c, 1.0, 1.0);
+        }, [](const std::vector<int>& starts, int k, const DistanceMatrix& d, const std::vector<int>& c, int t) {
+            std::function<int()> makeWorkspace = []() { return 0; };
+            std::function<std::vector<int>(int, int&)> build = [&](int start, int&) {
+                return greedyRegret2Weighted(start, k, d, c, 1.0, 1.0);
+            };
+            return buildBatch(starts, batchThreads(d, t), makeWorkspace, build);
+        }},
+    };
+
+    int mismatches = 0;
+    for (const std::string& filename : files) {
+        Instance instance = loadInstance(filename);
+        if (instance.size() == 0) return 1;
+        std::cout << filename << " (n=" << instance.size() << " starts, total ms)\n";
+        std::cout << "  " << std::left << std::setw(22) << "constructor" << std::right << std::setw(12) << "per call"
+                  << std::setw(12) << "batch x1" << std::setw(12) << ("batch x" + std::to_string(threads))
+                  << std::setw(10) << "speedup" << "\n";
+        for (const Constructor& constructor : constructors) {
+            mismatches += sweep(constructor, instance, threads);
+        }
+        std::cout << "\n";
+    }
+    return mismatches ? 1 : 0;
+}
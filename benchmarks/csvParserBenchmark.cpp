@@ -0,0 +1,114 @@
+// Instance CSV loading: the original getline/istringstream loop versus readInstanceCsv (mmap + from_chars)
+#include "../include/instance.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+struct Nodes {
+    std::vector<int> xs, ys, costs;
+};
+
+// The loop readInstanceCsv used before (copy per line, separators rewritten, istringstream)
+static Nodes readReference(const std::string& filename) {
+    Nodes nodes;
+    std::ifstream fin(filename);
+    std::string line;
+    while (std::getline(fin, line)) {
+        if (line.empty()) continue;
+        std::replace(line.begin(), line.end(), ';', ' ');
+        std::istringstream iss(line);
+        int x, y, cost;
+        if (iss >> x >> y >> cost) {
+            nodes.xs.push_back(x);
+            nodes.ys.push_back(y);
+            nodes.costs.push_back(cost);
+        }
+    }
+    return nodes;
+}
+
+// TSPA-like rows; crlf mimics the line endings of the course input files
+static void writeRandomCsv(const std::string& filename, int n, bool crlf, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> xDist(0, 4000), yDist(0, 2000), costDist(0, 2000);
+    std::ofstream fout(filename, std::ios::binary);
+    std::string buffer;
+    for (int i = 0; i < n; i++) {
+        buffer += std::to_string(xDist(rng));
+        buffer += ';';
+        buffer += std::to_string(yDist(rng));
+        buffer += ';';
+        buffer += std::to_string(costDist(rng));
+        buffer += crlf ? "\r\n" : "\n";
+    }
+    fout << buffer;
+}
+
+template<typename F>
+static double bestOfMs(int repeats, F f) {
+    double best = 1e18;
+    for (int r = 0; r < repeats; r++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        f();
+        auto end = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+static void compare(const std::string& label, const std::string& filename) {
+    double megabytes = std::filesystem::file_size(filename) / 1e6;
+    Nodes reference;
+    Instance parsed;
+    double referenceMs = bestOfMs(3, [&] { reference = readReference(filename); });
+    double parsedMs = bestOfMs(3, [&] { parsed = readInstanceCsv(filename, false); });
+    bool same = reference.xs == parsed.xs && reference.ys == parsed.ys && reference.costs == parsed.costs;
+    
+    std::cout << std::left << std::setw(24) << label << std::right << std::fixed << std::setprecision(1)
+              << std::setw(8) << megabytes << " MB"
+              << std::setw(12) << referenceMs << " ms"
+              << std::setw(12) << parsedMs << " ms"
+              << std::setw(9) << std::setprecision(1) << referenceMs / parsedMs << "x"
+              << std::setw(10) << (int)(megabytes / (parsedMs / 1000)) << " MB/s"
+              << "   " << (same ? "identical" : "MISMATCH") << "\n";
+}
+
+int main() {
+    std::cout << "Best of 3 runs, warm page cache\n";
+    std::cout << std::left << std::setw(24) << "file" << std::right << std::setw(11) << "size"
+              << std::setw(15) << "istringstream" << std::setw(15) << "from_chars"
+              << std::setw(10) << "speedup" << std::setw(15) << "throughput" << "\n";
+    
+    compare("TSPA.csv", "input/TSPA.csv");
+    compare("TSPB.csv", "input/TSPB.csv");
+    
+    std::string dir = std::filesystem::temp_directory_path().string();
+    for (int n : {1000000, 5000000}) {
+        for (bool crlf : {false, true}) {
+            std::string filename = dir + "/csvParserBenchmark_" + std::to_string(n) + (crlf ? "_crlf" : "") + ".csv";
+            writeRandomCsv(filename, n, crlf, 42);
+            compare("random n=" + std::to_string(n) + (crlf ? " CRLF" : " LF"), filename);
+            std::filesystem::remove(filename);
+        }
+    }
+    
+    // Malformed input is reported with its line number and yields an empty instance
+    std::string broken = dir + "/csvParserBenchmark_broken.csv";
+    {
+        std::ofstream fout(broken);
+        fout << "1;2;3\n4;5;6\n\n7;x;9\n";
+    }
+    std::cout << "\nMalformed file (expect line 4): ";
+    std::cout.flush();
+    Instance instance = readInstanceCsv(broken, false);
+    std::cout << "n=" << instance.size() << "\n";
+    std::filesystem::remove(broken);
+    return 0;
+}
@@ -0,0 +1,148 @@
+// Delta-evaluation throughput: vector<vector<int>> versus the flat and packed DistanceMatrix
+#include "../include/distanceMatrix.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <chrono>
+#include <cmath>
+
+struct BenchInstance {
+    std::string name;
+    std::vector<int> xs, ys, costs;
+};
+
+static BenchInstance readInstance(const std::string& filename) {
+    BenchInstance instance;
+    instance.name = filename;
+    std::ifstream fin(filename);
+    std::string line;
+    while (std::getline(fin, line)) {
+        if (line.empty()) continue;
+        std::replace(line.begin(), line.end(), ';', ' ');
+        std::istringstream iss(line);
+        int x, y, cost;
+        if (iss >> x >> y >> cost) {
+            instance.xs.push_back(x);
+            instance.ys.push_back(y);
+            instance.costs.push_back(cost);
+        }
+    }
+    return instance;
+}
+
+// Uniform instance with TSPA-like ranges (x < 4000, y < 2000, cost < 2000)
+static BenchInstance randomInstance(int n, unsigned seed) {
+    BenchInstance instance;
+    instance.name = "uniform n=" + std::to_string(n);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<> xDist(0, 4000), yDist(0, 2000), costDist(0, 2000);
+    for (int i = 0; i < n; i++) {
+        instance.xs.push_back(xDist(rng));
+        instance.ys.push_back(yDist(rng));
+        instance.costs.push_back(costDist(rng));
+    }
+    return instance;
+}
+
+// One steepest-descent sweep: all 2-opt and all exchange deltas for a half-size tour
+template<typename Matrix>
+static long long sweep(const std::vector<int>& sol, const std::vector<int>& nonSelected,
+                       const Matrix& distance, const std::vector<int>& costs) {
+    int m = sol.size();
+    long long checksum = 0;
+    for (int i = 0; i < m; i++) {
+        int a = sol[i], b = sol[(i + 1) % m];
+        for (int j = i + 2; j < m; j++) {
+            int c = sol[j], d = sol[(j + 1) % m];
+            int delta = distance[a][c] + distance[b][d] - distance[a][b] - distance[c][d];
+            checksum += delta < 0;
+        }
+    }
+    for (int i = 0; i < m; i++) {
+        int prev = sol[(i - 1 + m) % m], curr = sol[i], next = sol[(i + 1) % m];
+        int oldCost = distance[prev][curr] + distance[curr][next] + costs[curr];
+        for (int node : nonSelected) {
+            int delta = distance[prev][node] + distance[node][next] + costs[node] - oldCost;
+            checksum += delta < 0;
+        }
+    }
+    return checksum;
+}
+
+template<typename Matrix>
+static void measure(const std::string& label, const std::vector<int>& sol, const std::vector<int>& nonSelected,
+                    const Matrix& distance, const std::vector<int>& costs, double& baselineRate) {
+    long long m = sol.size();
+    long long evalsPerSweep = m * (m - 1) / 2 + m * (long long)nonSelected.size();
+    int sweeps = std::max(1LL, 200000000LL / evalsPerSweep);
+    long long checksum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int s = 0; s < sweeps; s++) checksum += sweep(sol, nonSelected, distance, costs);
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double rate = evalsPerSweep * sweeps / seconds / 1e6;
+    if (baselineRate == 0) baselineRate = rate;
+    std::cout << "  " << std::left << std::setw(24) << label << std::right
+              << std::setw(10) << std::fixed << std::setprecision(1) << rate << " M deltas/s"
+              << "  x" << std::setprecision(2) << rate / baselineRate
+              << "  (checksum " << checksum << ")\n" << std::flush;
+}
+
+static void run(const BenchInstance& instance) {
+    int n = instance.xs.size();
+    std::cout << instance.name << " (n=" << n << "):\n";
+
+    std::vector<std::vector<int>> nested(n, std::vector<int>(n));
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            double dx = instance.xs[i] - instance.xs[j];
+            double dy = instance.ys[i] - instance.ys[j];
+            nested[i][j] = round(sqrt(dx * dx + dy * dy));
+        }
+    }
+    DistanceMatrix flat32 = DistanceMatrix::fromCoordinates(instance.xs, instance.ys, DistanceWidth::Int32);
+    DistanceMatrix flat16 = DistanceMatrix::fromCoordinates(instance.xs, instance.ys, DistanceWidth::Int16);
+    DistanceMatrix packed32 = DistanceMatrix::packed(instance.xs, instance.ys, DistanceWidth::Int32);
+    DistanceMatrix packed16 = DistanceMatrix::packed(instance.xs, instance.ys, DistanceWidth::Int16);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (packed16[i][j] != flat16[i][j] || packed32[i][j] != flat32[i][j]) {
+                std::cout << "  packed mismatch at (" << i << ", " << j << ")\n";
+                return;
+            }
+        }
+    }
+
+    std::mt19937 rng(12345);
+    std::vector<int> nodes(n);
+    std::iota(nodes.begin(), nodes.end(), 0);
+    std::shuffle(nodes.begin(), nodes.end(), rng);
+    std::vector<int> sol(nodes.begin(), nodes.begin() + (n + 1) / 2);
+    std::vector<int> nonSelected(nodes.begin() + (n + 1) / 2, nodes.end());
+    std::sort(nonSelected.begin(), nonSelected.end());
+
+    double baselineRate = 0;
+    measure("vector<vector<int>>", sol, nonSelected, nested, instance.costs, baselineRate);
+    measure("DistanceMatrix int32", sol, nonSelected, flat32, instance.costs, baselineRate);
+    measure("DistanceMatrix int16", sol, nonSelected, flat16, instance.costs, baselineRate);
+    measure("packed int32", sol, nonSelected, packed32, instance.costs, baselineRate);
+    measure("packed int16", sol, nonSelected, packed16, instance.costs, baselineRate);
+    std::cout << "  memory: full int16 " << flat16.bytes() / 1000 << " kB, packed int16 "
+              << packed16.bytes() / 1000 << " kB\n";
+    std::cout << "\n";
+}
+
+int main() {
+    run(readInstance("input/TSPA.csv"));
+    run(readInstance("input/TSPB.csv"));
+    for (int n : {1000, 2000, 5000}) {
+        run(randomInstance(n, 12345 + n));
+    }
+    return 0;
+}
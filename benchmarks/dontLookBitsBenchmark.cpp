@@ -0,0 +1,97 @@
+// Full steepest edges local search versus the don't-look-bits variant with
+// neighbour lists: single runs from random starts, then ILS with the same
+// time limit using each of them (LS runs completed and best objective).
+//
+// Usage: ./benchmark.sh dontLookBits [csv ...] [--starts=S] [--ils-ms=T] [--ils-runs=R]
+//   defaults: input/TSPA.csv input/TSPB.csv, 20 starts, T = 1000 ms, 3 ILS runs
+#include "../include/constants.h"
+#include "../include/instance.h"
+#include "../include/calculateObjective.h"
+#include "../include/randomSolution.h"
+#include "../include/localSearch.h"
+#include "../include/candidateMoves.h"
+#include "../include/iteratedLS.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <climits>
+#include <algorithm>
+
+static void printRow(const std::string& name, double ms, double objective, double third) {
+    std::cout << "  " << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << ms << std::setprecision(0) << std::setw(14) << objective
+              << std::setw(12) << third << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> files;
+    int starts = 20;
+    double ilsMs = 1000;
+    int ilsRuns = 3;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--starts=", 0) == 0) {
+            starts = std::stoi(arg.substr(9));
+        } else if (arg.rfind("--ils-ms=", 0) == 0) {
+            ilsMs = std::stod(arg.substr(9));
+        } else if (arg.rfind("--ils-runs=", 0) == 0) {
+            ilsRuns = std::stoi(arg.substr(11));
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) files = {"input/TSPA.csv", "input/TSPB.csv"};
+
+    for (const std::string& filename : files) {
+        Instance instance = loadInstance(filename);
+        int n = instance.size();
+        if (n == 0) return 1;
+        int selectCount = (n + 1) / 2;
+        const DistanceMatrix& distance = instance.distance;
+        const std::vector<int>& costs = instance.costs;
+
+        std::mt19937 rng(DEFAULT_SEED);
+        std::vector<std::vector<int>> initials;
+        for (int s = 0; s < starts; s++) initials.push_back(randomSolution(s % n, n, selectCount, rng));
+
+        std::cout << filename << " (n=" << n << ", " << starts << " random starts)\n";
+        std::cout << "  " << std::left << std::setw(22) << "local search" << std::right << std::setw(12) << "avg ms"
+                  << std::setw(14) << "avg obj" << std::setw(12) << "best obj" << "\n";
+        std::vector<std::vector<int>> neighbors = buildNearestNeighbors(n, distance, costs, DONT_LOOK_NEIGHBORS);
+        for (LocalSearchKind kind : {LocalSearchKind::SteepestEdges, LocalSearchKind::DontLookBits}) {
+            double sumMs = 0, sumObjective = 0;
+            int bestObjective = INT_MAX;
+            for (const auto& initial : initials) {
+                auto begin = std::chrono::high_resolution_clock::now();
+                std::vector<int> solution = runLocalSearch(kind, initial, distance, costs, n, neighbors);
+                auto end = std::chrono::high_resolution_clock::now();
+                sumMs += std::chrono::duration<double, std::milli>(end - begin).count();
+                int objective = calculateObjective(solution, distance, costs);
+                sumObjective += objective;
+                bestObjective = std::min(bestObjective, objective);
+            }
+            printRow(kind == LocalSearchKind::SteepestEdges ? "Steepest + Edges" : "Don't-look bits (k=10)",
+                     sumMs / starts, sumObjective / starts, bestObjective);
+        }
+
+        std::cout << "  " << std::left << std::setw(22) << "ILS" << std::right << std::setw(12) << "limit ms"
+                  << std::setw(14) << "avg best" << std::setw(12) << "LS runs" << "\n";
+        for (LocalSearchKind kind : {LocalSearchKind::SteepestEdges, LocalSearchKind::DontLookBits}) {
+            double sumObjective = 0, sumRuns = 0;
+            std::mt19937 ilsRng(DEFAULT_SEED);
+            for (int run = 0; run < ilsRuns; run++) {
+                std::vector<std::vector<int>> randomInitials = {randomSolution(run % n, n, selectCount, ilsRng)};
+                ILSResult result = iteratedLS(n, selectCount, distance, costs, randomInitials, ilsMs, ilsRng, kind);
+                sumObjective += result.bestObjective;
+                sumRuns += result.lsRuns;
+            }
+            printRow(kind == LocalSearchKind::SteepestEdges ? "ILS Steepest" : "ILS Don't-look bits",
+                     ilsMs, sumObjective / ilsRuns, sumRuns / ilsRuns);
+        }
+        std::cout << "\n";
+    }
+    return 0;
+}
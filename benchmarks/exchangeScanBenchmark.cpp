@@ -0,0 +1,129 @@
+// Inter-route exchange scans: the scalar loop over 0..n-1 skipping selected
+// nodes versus bestExchange / improvingExchanges over the compacted
+// ExchangeCandidates (AVX2 when available), for every position of random
+// tours. Checks that both give the same best move and the same improving list.
+//
+// Usage: ./benchmark.sh exchangeScan [csv ...] [--tours=T]
+//   defaults: input/TSPA.csv input/TSPB.csv, 20 tours
+// Exits with status 1 if any scan differs.
+#include "../include/constants.h"
+#include "../include/instance.h"
+#include "../include/randomSolution.h"
+#include "../include/exchangeScan.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <climits>
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> files;
+    int tours = 20;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--tours=", 0) == 0) {
+            tours = std::stoi(arg.substr(8));
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) files = {"input/TSPA.csv", "input/TSPB.csv"};
+
+    int mismatches = 0;
+    for (const std::string& filename : files) {
+        Instance instance = loadInstance(filename);
+        int n = instance.size();
+        if (n == 0) return 1;
+        int selectCount = (n + 1) / 2;
+        const DistanceMatrix& distance = instance.distance;
+        const std::vector<int>& costs = instance.costs;
+
+        double scalarBestMs = 0, kernelBestMs = 0, scalarListMs = 0, kernelListMs = 0;
+        long long scans = 0;
+        std::mt19937 rng(DEFAULT_SEED);
+        for (int t = 0; t < tours; t++) {
+            std::vector<int> sol = randomSolution(t % n, n, selectCount, rng);
+            int m = sol.size();
+            std::vector<bool> inSolution(n, false);
+            for (int node : sol) inSolution[node] = true;
+            ExchangeCandidates unselected(inSolution, costs);
+
+            std::vector<int> prev(m), next(m), removed(m);
+            for (int pos = 0; pos < m; pos++) {
+                prev[pos] = sol[(pos - 1 + m) % m];
+                next[pos] = sol[(pos + 1) % m];
+                removed[pos] = distance[prev[pos]][sol[pos]] + distance[sol[pos]][next[pos]] + costs[sol[pos]];
+            }
+            scans += m;
+
+            // Best exchange per position
+            std::vector<ExchangeDelta> expected(m), actual(m);
+            auto begin = std::chrono::high_resolution_clock::now();
+            for (int pos = 0; pos < m; pos++) {
+                ExchangeDelta best = {-1, INT_MAX};
+                for (int node = 0; node < n; node++) {
+                    if (inSolution[node]) continue;
+                    int delta = distance[prev[pos]][node] + distance[node][next[pos]] + costs[node] - removed[pos];
+                    if (delta < best.delta) best = {node, delta};
+                }
+                expected[pos] = best;
+            }
+            scalarBestMs += elapsedMs(begin);
+            begin = std::chrono::high_resolution_clock::now();
+            for (int pos = 0; pos < m; pos++) {
+                actual[pos] = bestExchange(unselected, prev[pos], next[pos], removed[pos], distance);
+            }
+            kernelBestMs += elapsedMs(begin);
+            for (int pos = 0; pos < m; pos++) {
+                if (actual[pos].node != expected[pos].node || actual[pos].delta != expected[pos].delta) mismatches++;
+            }
+
+            // Every improving exchange per position
+            std::vector<ExchangeDelta> expectedList, actualList;
+            begin = std::chrono::high_resolution_clock::now();
+            for (int pos = 0; pos < m; pos++) {
+                for (int node = 0; node < n; node++) {
+                    if (inSolution[node]) continue;
+                    int delta = distance[prev[pos]][node] + distance[node][next[pos]] + costs[node] - removed[pos];
+                    if (delta < 0) expectedList.push_back({node, delta});
+                }
+            }
+            scalarListMs += elapsedMs(begin);
+            begin = std::chrono::high_resolution_clock::now();
+            for (int pos = 0; pos < m; pos++) {
+                improvingExchanges(unselected, prev[pos], next[pos], removed[pos], distance, actualList);
+            }
+            kernelListMs += elapsedMs(begin);
+            if (actualList.size() != expectedList.size()) {
+                mismatches++;
+            } else {
+                for (size_t i = 0; i < actualList.size(); i++) {
+                    if (actualList[i].node != expectedList[i].node || actualList[i].delta != expectedList[i].delta) {
+                        mismatches++;
+                        break;
+                    }
+                }
+            }
+        }
+
+        std::cout << filename << " (n=" << n << ", " << scans << " position scans, ns per candidate)\n";
+        double candidates = (double)scans * (n - selectCount);
+        std::cout << "  " << std::left << std::setw(20) << "scan" << std::right << std::setw(10) << "scalar"
+                  << std::setw(10) << "kernel" << std::setw(10) << "speedup" << "\n";
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "  " << std::left << std::setw(20) << "best exchange" << std::right
+                  << std::setw(10) << 1e6 * scalarBestMs / candidates << std::setw(10) << 1e6 * kernelBestMs / candidates
+                  << std::setprecision(1) << std::setw(9) << scalarBestMs / kernelBestMs << "x\n" << std::setprecision(3);
+        std::cout << "  " << std::left << std::setw(20) << "improving list" << std::right
+                  << std::setw(10) << 1e6 * scalarListMs / candidates << std::setw(10) << 1e6 * kernelListMs / candidates
+                  << std::setprecision(1) << std::setw(9) << scalarListMs / kernelListMs << "x\n";
+        std::cout << (mismatches ? "  MISMATCH\n" : "  identical\n") << "\n";
+    }
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,140 @@
+// The 1000 local optima of analyzeGlobalConvexity (random start, greedy local
+// search) built with the original greedy loop (rebuilt lists, a tried bitmap
+// per improvement, rejection sampling) versus the RandomMoveOrder one. Random
+// orders differ, so the objectives are compared as distributions.
+//
+// Usage: ./benchmark.sh greedyLocalSearch [csv ...] [--optima=K]
+//   defaults: input/TSPA.csv input/TSPB.csv, K = 1000
+#include "../include/constants.h"
+#include "../include/instance.h"
+#include "../include/randomSolution.h"
+#include "../include/localSearch.h"
+#include "../include/moveDeltas.h"
+#include "../include/calculateObjective.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+
+// The loop both greedy searches used before
+static std::vector<int> referenceGreedy(const std::vector<int>& initialSolution, const DistanceMatrix& distance,
+                                        const std::vector<int>& costs, int n, std::mt19937& rng, bool edges) {
+    std::vector<int> sol = initialSolution;
+    std::vector<bool> inSolution(n, false);
+    for (int node : sol) inSolution[node] = true;
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        int solSize = sol.size();
+        std::vector<int> nonSelected;
+        for (int i = 0; i < n; i++) {
+            if (!inSolution[i]) nonSelected.push_back(i);
+        }
+        int numIntra = solSize * (solSize - 1) / 2;
+        int numInter = solSize * nonSelected.size();
+        int totalMoves = numIntra + numInter;
+        std::vector<bool> tried(totalMoves, false);
+        int triedCount = 0;
+        std::uniform_int_distribution<> moveDist(0, totalMoves - 1);
+        while (!improved && triedCount < totalMoves) {
+            int moveIdx = moveDist(rng);
+            if (tried[moveIdx]) continue;
+            tried[moveIdx] = true;
+            triedCount++;
+            if (moveIdx < numInter) {
+                int pos = moveIdx / nonSelected.size();
+                int node = nonSelected[moveIdx % nonSelected.size()];
+                if (deltaExchangeNodes(sol, pos, node, distance, costs) < 0) {
+                    inSolution[sol[pos]] = false;
+                    inSolution[node] = true;
+                    sol[pos] = node;
+                    improved = true;
+                }
+            } else {
+                int pairIdx = moveIdx - numInter;
+                int i = (int)((2*solSize + 1 - sqrt((2*solSize + 1)*(2*solSize + 1) - 8.0*pairIdx)) / 2);
+                int j = pairIdx - (i * solSize - i * (i + 1) / 2) + i + 1;
+                if (i >= 0 && i < solSize && j > i && j < solSize) {
+                    int delta = edges ? deltaReverseSegment(sol, i, j, distance) : deltaSwapNodes(sol, i, j, distance);
+                    if (delta < 0) {
+                        if (edges) {
+                            std::reverse(sol.begin() + i + 1, sol.begin() + j + 1);
+                        } else {
+                            std::swap(sol[i], sol[j]);
+                        }
+                        improved = true;
+                    }
+                }
+            }
+        }
+    }
+    return sol;
+}
+
+using Greedy = std::function<std::vector<int>(const std::vector<int>&, std::mt19937&)>;
+
+// Time and objectives of optima generated like analyzeGlobalConvexity does
+static void generate(const std::string& name, const Greedy& greedy, const Instance& instance, int optima) {
+    int n = instance.size();
+    int selectCount = (n + 1) / 2;
+    std::mt19937 rng(DEFAULT_SEED);
+    long long sum = 0;
+    int best = INT_MAX, worst = INT_MIN;
+    auto begin = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < optima; i++) {
+        std::uniform_int_distribution<> startDist(0, n - 1);
+        int start = startDist(rng);
+        std::vector<int> optimum = greedy(randomSolution(start, n, selectCount, rng), rng);
+        int objective = calculateObjective(optimum, instance.distance, instance.costs);
+        sum += objective;
+        best = std::min(best, objective);
+        worst = std::max(worst, objective);
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+    std::cout << "  " << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(10) << ms << std::setw(10) << (double)sum / optima
+              << std::setw(10) << best << std::setw(10) << worst << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> files;
+    int optima = 1000;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--optima=", 0) == 0) {
+            optima = std::stoi(arg.substr(9));
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) files = {"input/TSPA.csv", "input/TSPB.csv"};
+
+    for (const std::string& filename : files) {
+        Instance instance = loadInstance(filename);
+        int n = instance.size();
+        if (n == 0) return 1;
+        const DistanceMatrix& distance = instance.distance;
+        const std::vector<int>& costs = instance.costs;
+
+        std::cout << filename << " (n=" << n << ", " << optima << " local optima)\n";
+        std::cout << "  " << std::left << std::setw(22) << "greedy local search" << std::right << std::setw(10) << "ms"
+                  << std::setw(10) << "avg obj" << std::setw(10) << "best" << std::setw(10) << "worst" << "\n";
+        for (bool edges : {true, false}) {
+            generate(edges ? "Edges, original" : "Nodes, original", [&](const std::vector<int>& initial, std::mt19937& rng) {
+                return referenceGreedy(initial, distance, costs, n, rng, edges);
+            }, instance, optima);
+            generate(edges ? "Edges, move order" : "Nodes, move order", [&](const std::vector<int>& initial, std::mt19937& rng) {
+                return edges ? localSearchGreedyEdges(initial, distance, costs, n, rng)
+                             : localSearchGreedyNodes(initial, distance, costs, n, rng);
+            }, instance, optima);
+        }
+        std::cout << "\n";
+    }
+    return 0;
+}
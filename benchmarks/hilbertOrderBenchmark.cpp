@@ -0,0 +1,112 @@
+// Local search time with nodes in CSV order versus renumbered along a Hilbert curve,
+// on the synthetic instances written by ./generate.sh.
+//
+// Usage: ./benchmark.sh hilbertOrder [n ...] [--starts=S]
+//   defaults: n = 1000 2000, 5 starts
+// Both orders start from the same random solutions (mapped to the new ids), so
+// only the memory layout differs; objectives may differ slightly because ties
+// between equal moves are broken by node id.
+#include "../include/constants.h"
+#include "../include/instance.h"
+#include "../include/calculateObjective.h"
+#include "../include/randomSolution.h"
+#include "../include/localSearch.h"
+#include "../include/candidateMoves.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <functional>
+#include <chrono>
+#include <filesystem>
+
+struct LocalSearch {
+    std::string name;
+    std::function<std::vector<int>(const std::vector<int>&, const Instance&)> run;
+};
+
+struct Measurement {
+    double avgMs = 0;
+    long long avgObjective = 0;
+};
+
+static Measurement measure(const LocalSearch& ls, const Instance& instance,
+                           const std::vector<std::vector<int>>& initials) {
+    double sumMs = 0;
+    long long sumObjective = 0;
+    for (const auto& initial : initials) {
+        auto begin = std::chrono::high_resolution_clock::now();
+        std::vector<int> solution = ls.run(initial, instance);
+        auto end = std::chrono::high_resolution_clock::now();
+        sumMs += std::chrono::duration<double, std::milli>(end - begin).count();
+        sumObjective += calculateObjective(solution, instance.distance, instance.costs);
+    }
+    return {sumMs / initials.size(), sumObjective / (long long)initials.size()};
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes;
+    int starts = 5;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--starts=", 0) == 0) {
+            starts = std::stoi(arg.substr(9));
+        } else {
+            sizes.push_back(std::stoi(arg));
+        }
+    }
+    if (sizes.empty()) sizes = {1000, 2000};
+
+    std::vector<LocalSearch> searches = {
+        {"Steepest + Edges", [](const std::vector<int>& initial, const Instance& instance) {
+            return localSearchSteepestEdges(initial, instance.distance, instance.costs, instance.size());
+        }},
+        {"LM Steepest + Edges", [](const std::vector<int>& initial, const Instance& instance) {
+            return localSearchSteepestEdgesLM(initial, instance.distance, instance.costs, instance.size());
+        }},
+        {"Candidates (k=10)", [](const std::vector<int>& initial, const Instance& instance) {
+            return localSearchSteepestEdgesCandidates(initial, instance.distance, instance.costs, instance.size(), 10);
+        }},
+        {"LM Candidates (k=10)", [](const std::vector<int>& initial, const Instance& instance) {
+            return localSearchSteepestEdgesLMCandidates(initial, instance.distance, instance.costs, instance.size(), 10);
+        }},
+    };
+
+    for (std::string variant : {"TSPA_uniform", "TSPA_clustered"}) {
+        for (int n : sizes) {
+            std::string filename = "input/generated/" + variant + "_" + std::to_string(n) + ".csv";
+            if (!std::filesystem::exists(filename)) {
+                std::cout << filename << " not found, run ./generate.sh first\n";
+                continue;
+            }
+            Instance csvOrder = loadInstance(filename);
+            Instance hilbert = csvOrder;
+            renumberNodes(hilbert, hilbertOrder(csvOrder.xs, csvOrder.ys), 0);
+
+            std::vector<int> newId(n);
+            for (int i = 0; i < n; i++) newId[hilbert.originalIds[i]] = i;
+            std::mt19937 rng(DEFAULT_SEED);
+            std::vector<std::vector<int>> csvInitials, hilbertInitials;
+            for (int s = 0; s < starts; s++) {
+                csvInitials.push_back(randomSolution(s * n / starts, n, (n + 1) / 2, rng));
+                hilbertInitials.emplace_back();
+                for (int node : csvInitials.back()) hilbertInitials.back().push_back(newId[node]);
+            }
+
+            std::cout << "\n" << variant << " n=" << n << " (" << starts << " random starts)\n";
+            std::cout << std::left << std::setw(24) << "local search" << std::right << std::setw(12) << "csv ms"
+                      << std::setw(12) << "hilbert ms" << std::setw(10) << "speedup" << std::setw(14) << "csv obj"
+                      << std::setw(14) << "hilbert obj" << "\n";
+            for (const LocalSearch& ls : searches) {
+                Measurement a = measure(ls, csvOrder, csvInitials);
+                Measurement b = measure(ls, hilbert, hilbertInitials);
+                std::cout << std::left << std::setw(24) << ls.name << std::right << std::fixed << std::setprecision(1)
+                          << std::setw(12) << a.avgMs << std::setw(12) << b.avgMs << std::setprecision(2)
+                          << std::setw(9) << a.avgMs / b.avgMs << "x" << std::setw(14) << a.avgObjective
+                          << std::setw(14) << b.avgObjective << "\n" << std::flush;
+            }
+        }
+    }
+    return 0;
+}
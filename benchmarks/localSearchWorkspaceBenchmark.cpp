@@ -0,0 +1,192 @@
+// Local searches from random starts, each call in a fresh workspace (the
+// overloads without one) versus one LSWorkspace reused for every call. Counts
+// heap allocations per call, then repeats every start in the warm workspace:
+// once the first pass has sized it, no call may allocate (the list of moves
+// only grows past its capacity on a longer list than any earlier call).
+// Checks that both end in the same solutions.
+// Then runs ILS and LNS iterations (step and acceptance, as in their loops)
+// in one ILSWorkspace / LNSWorkspace: once the warm-up iterations have sized
+// it, an iteration must not allocate either.
+//
+// Usage: ./benchmark.sh localSearchWorkspace [csv ...] [--starts=S]
+//   defaults: input/TSPA.csv input/TSPB.csv, 50 starts
+// Exits with status 1 if any solution differs, a reused workspace allocates
+// or an ILS/LNS iteration after the warm-up allocates.
+#include "allocationCounter.h"
+#include "../include/constants.h"
+#include "../include/instance.h"
+#include "../include/randomSolution.h"
+#include "../include/localSearch.h"
+#include "../include/candidateMoves.h"
+#include "../include/calculateObjective.h"
+#include "../include/iteratedLS.h"
+#include "../include/largeNeighborhoodSearch.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+
+static const char* const SEARCHES[] = {"SteepestEdges", "SteepestNodes", "GreedyEdges", "DontLookBits",
+                                       "SteepestEdgesLM", "Candidates", "LMCandidates"};
+
+static const std::vector<int>& run(int search, const std::vector<int>& initial, const Instance& instance,
+                                   const std::vector<std::vector<int>>& neighbors, int seed, LSWorkspace& workspace) {
+    const DistanceMatrix& distance = instance.distance;
+    const std::vector<int>& costs = instance.costs;
+    int n = instance.size();
+    std::mt19937 rng(seed);
+    switch (search) {
+        case 0: return localSearchSteepestEdges(initial, distance, costs, n, workspace);
+        case 1: return localSearchSteepestNodes(initial, distance, costs, n, workspace);
+        case 2: return localSearchGreedyEdges(initial, distance, costs, n, rng, workspace);
+        case 3: return localSearchDontLookBits(initial, distance, costs, n, neighbors, workspace);
+        case 4: return localSearchSteepestEdgesLM(initial, distance, costs, n, workspace);
+        case 5: return localSearchSteepestEdgesCandidates(initial, distance, costs, n, neighbors, workspace);
+        default: return localSearchSteepestEdgesLMCandidates(initial, distance, costs, n, neighbors, workspace);
+    }
+}
+
+static std::vector<int> runFresh(int search, const std::vector<int>& initial, const Instance& instance,
+                                 const std::vector<std::vector<int>>& neighbors, int seed) {
+    const DistanceMatrix& distance = instance.distance;
+    const std::vector<int>& costs = instance.costs;
+    int n = instance.size();
+    std::mt19937 rng(seed);
+    switch (search) {
+        case 0: return localSearchSteepestEdges(initial, distance, costs, n);
+        case 1: return localSearchSteepestNodes(initial, distance, costs, n);
+        case 2: return localSearchGreedyEdges(initial, distance, costs, n, rng);
+        case 3: return localSearchDontLookBits(initial, distance, costs, n, neighbors);
+        case 4: return localSearchSteepestEdgesLM(initial, distance, costs, n);
+        // Building the neighbour lists per call, as these overloads do
+        case 5: return localSearchSteepestEdgesCandidates(initial, distance, costs, n, DONT_LOOK_NEIGHBORS);
+        default: return localSearchSteepestEdgesLMCandidates(initial, distance, costs, n, DONT_LOOK_NEIGHBORS);
+    }
+}
+
+// Iterations measured after the warm-up ones
+constexpr int WARMUP_ITERATIONS = 20;
+constexpr int MEASURED_ITERATIONS = 20;
+
+// Allocations of the measured iterations of step(current), accepting improvements like ILS/LNS
+template <class Step>
+static size_t iterationAllocations(const std::vector<int>& start, const Instance& instance, Step step) {
+    std::vector<int> current = start;
+    int currentObjective = calculateObjective(current, instance.distance, instance.costs);
+    size_t allocations = 0;
+    for (int iteration = 0; iteration < WARMUP_ITERATIONS + MEASURED_ITERATIONS; iteration++) {
+        size_t before = allocationCounter::allocations;
+        const std::vector<int>& next = step(current);
+        int objective = calculateObjective(next, instance.distance, instance.costs);
+        if (objective < currentObjective) {
+            current = next;
+            currentObjective = objective;
+        }
+        if (iteration >= WARMUP_ITERATIONS) allocations += allocationCounter::allocations - before;
+    }
+    return allocations;
+}
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> files;
+    int starts = 50;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--starts=", 0) == 0) {
+            starts = std::stoi(arg.substr(9));
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) files = {"input/TSPA.csv", "input/TSPB.csv"};
+
+    int failures = 0;
+    for (const std::string& filename : files) {
+        Instance instance = loadInstance(filename);
+        int n = instance.size();
+        if (n == 0) return 1;
+        int selectCount = (n + 1) / 2;
+        std::vector<std::vector<int>> neighbors =
+            buildNearestNeighbors(n, instance.distance, instance.costs, DONT_LOOK_NEIGHBORS);
+
+        std::mt19937 rng(DEFAULT_SEED);
+        std::vector<std::vector<int>> initials;
+        for (int s = 0; s < starts; s++) initials.push_back(randomSolution(s % n, n, selectCount, rng));
+
+        std::cout << filename << " (n=" << n << ", " << starts << " starts)\n";
+        std::cout << "  " << std::left << std::setw(18) << "search" << std::right << std::setw(12) << "fresh ms"
+                  << std::setw(14) << "allocs/call" << std::setw(12) << "reused ms" << std::setw(14) << "allocs/call"
+                  << std::setw(14) << "warm allocs" << "\n";
+        for (int search = 0; search < (int)(sizeof(SEARCHES) / sizeof(SEARCHES[0])); search++) {
+            std::vector<std::vector<int>> fresh(starts);
+            size_t before = allocationCounter::allocations;
+            auto begin = std::chrono::high_resolution_clock::now();
+            for (int s = 0; s < starts; s++) fresh[s] = runFresh(search, initials[s], instance, neighbors, s);
+            double freshMs = elapsedMs(begin);
+            size_t freshAllocations = allocationCounter::allocations - before;
+
+            // The comparison copies into vectors sized up front, so it does not allocate either
+            LSWorkspace workspace(n);
+            std::vector<int> result;
+            result.reserve(n);
+            int differing = 0;
+            before = allocationCounter::allocations;
+            begin = std::chrono::high_resolution_clock::now();
+            for (int s = 0; s < starts; s++) {
+                result = run(search, initials[s], instance, neighbors, s, workspace);
+                if (result != fresh[s]) differing++;
+            }
+            double reusedMs = elapsedMs(begin);
+            size_t reusedAllocations = allocationCounter::allocations - before;
+
+            before = allocationCounter::allocations;
+            for (int s = 0; s < starts; s++) result = run(search, initials[s], instance, neighbors, s, workspace);
+            size_t warmAllocations = allocationCounter::allocations - before;
+
+            std::cout << "  " << std::left << std::setw(18) << SEARCHES[search] << std::right << std::fixed
+                      << std::setprecision(1) << std::setw(12) << freshMs << std::setw(14)
+                      << (double)freshAllocations / starts << std::setw(12) << reusedMs << std::setw(14)
+                      << (double)reusedAllocations / starts << std::setw(14) << warmAllocations;
+            if (differing > 0) std::cout << "  " << differing << " solutions DIFFER";
+            if (warmAllocations > 0) std::cout << "  ALLOCATES";
+            std::cout << "\n";
+            if (differing > 0 || warmAllocations > 0) failures++;
+        }
+
+        const DistanceMatrix& distance = instance.distance;
+        const std::vector<int>& costs = instance.costs;
+        std::vector<int> start = localSearchSteepestEdges(initials[0], distance, costs, n);
+        std::cout << "  " << std::left << std::setw(18) << "metaheuristic" << std::right << std::setw(14)
+                  << "allocs in " << MEASURED_ITERATIONS << " iterations after " << WARMUP_ITERATIONS << "\n";
+        for (int metaheuristic = 0; metaheuristic < 4; metaheuristic++) {
+            static const char* const NAMES[] = {"ILS Steepest", "ILS DontLookBits", "LNS with LS", "LNS without LS"};
+            std::mt19937 metaRng(DEFAULT_SEED);
+            size_t allocations;
+            if (metaheuristic < 2) {
+                LocalSearchKind kind = metaheuristic == 0 ? LocalSearchKind::SteepestEdges : LocalSearchKind::DontLookBits;
+                ILSWorkspace workspace(n);
+                allocations = iterationAllocations(start, instance, [&](const std::vector<int>& current) -> const std::vector<int>& {
+                    return iteratedLSStep(current, distance, costs, n, neighbors, kind, metaRng, workspace);
+                });
+            } else {
+                bool withLocalSearch = metaheuristic == 2;
+                LNSWorkspace workspace(distance, costs, n);
+                allocations = iterationAllocations(start, instance, [&](const std::vector<int>& current) -> const std::vector<int>& {
+                    return largeNeighborhoodSearchStep(current, n, selectCount, distance, costs, 0.30, withLocalSearch,
+                                                       LocalSearchKind::SteepestEdges, neighbors, metaRng, workspace);
+                });
+            }
+            std::cout << "  " << std::left << std::setw(18) << NAMES[metaheuristic] << std::right << std::setw(14)
+                      << allocations << (allocations > 0 ? "  ALLOCATES" : "") << "\n";
+            if (allocations > 0) failures++;
+        }
+        std::cout << "\n";
+    }
+    return failures > 0 ? 1 : 0;
+}
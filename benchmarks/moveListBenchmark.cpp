@@ -0,0 +1,171 @@
+// List-of-moves steepest edges local search (full and candidate
+// neighbourhoods): the original sorted vector, compacted, sorted and merged
+// every step, with the position map rebuilt after every move, versus the
+// binary heap with lazy deletion and incremental positions. The heap breaks
+// ties of equal (delta, type, a1) by insertion order and a 2-opt there may
+// reverse the other side of the cycle, which flips the direction edges are
+// stored in, so the runs take different paths among equal moves; the
+// objectives are compared as averages and the identical final solutions are
+// counted.
+//
+// Usage: ./benchmark.sh moveList [csv ...] [--starts=S]
+//   defaults: input/TSPA.csv input/TSPB.csv, 50 starts
+#include "../include/constants.h"
+#include "../include/instance.h"
+#include "../include/randomSolution.h"
+#include "../include/calculateObjective.h"
+#include "../include/candidateMoves.h"
+#include "../include/localSearch.h"
+#include "../include/localSearchEngine.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+// The loop localSearchSteepestEdgesLM used before: dead moves removed and new
+// moves sorted and merged into the sorted list after every applied move
+template <class Restriction>
+static std::vector<int> referenceMoveList(const std::vector<int>& initialSolution, const DistanceMatrix& distance,
+                                          const std::vector<int>& costs, int n, const Restriction& restriction) {
+    using namespace localSearchDetail;
+    std::vector<int> sol = initialSolution;
+    int sz = sol.size();
+    std::vector<bool> inSolution(n, false);
+    for (int node : sol) inSolution[node] = true;
+    ExchangeCandidates unselected(inSolution, costs);
+    std::vector<int> nodePos(n);
+    buildNodePositions(sol, nodePos);
+
+    std::vector<LMMove> LM, newMoves;
+    std::vector<ExchangeDelta> exchanges;
+    std::vector<int> allIndices(sz);
+    for (int i = 0; i < sz; i++) allIndices[i] = i;
+    generateMovesForNodes(allIndices, sol, unselected, distance, costs, restriction, LM, exchanges, true);
+    std::sort(LM.begin(), LM.end());
+
+    auto dead = [](const LMMove& m) { return m.delta >= 0; };
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        LM.erase(std::remove_if(LM.begin(), LM.end(), dead), LM.end());
+
+        LMMove applied;
+        for (LMMove& m : LM) {
+            if (m.type == 1 && inSolution[m.newNode]) {
+                m.delta = 0;
+                continue;
+            }
+            bool dir1, dir2;
+            if (!edgeExistsUndirected(sol, nodePos, m.a1, m.b1, dir1) ||
+                !edgeExistsUndirected(sol, nodePos, m.a2, m.b2, dir2)) {
+                m.delta = 0;
+                continue;
+            }
+            if (dir1 != dir2) continue;
+            improved = true;
+            applied = m;
+            if (m.type == 0) {
+                int u = dir1 ? nodePos[m.a1] : nodePos[m.b1];
+                int v = dir2 ? nodePos[m.a2] : nodePos[m.b2];
+                if (u > v) std::swap(u, v);
+                std::reverse(sol.begin() + u + 1, sol.begin() + v + 1);
+            } else {
+                int pos = nodePos[m.b1];
+                inSolution[sol[pos]] = false;
+                inSolution[m.newNode] = true;
+                unselected.exchange(sol[pos], m.newNode);
+                sol[pos] = m.newNode;
+            }
+            break;
+        }
+        if (!improved) break;
+
+        buildNodePositions(sol, nodePos);
+        std::vector<int> touched;
+        if (applied.type == 0) {
+            int p1 = nodePos[applied.a1]; if (p1 < 0) p1 = nodePos[applied.b1];
+            int p2 = nodePos[applied.a2]; if (p2 < 0) p2 = nodePos[applied.b2];
+            touched = {p1, (p1 + 1) % sz, (p1 - 1 + sz) % sz, p2, (p2 + 1) % sz, (p2 - 1 + sz) % sz};
+        } else {
+            int pos = nodePos[applied.newNode];
+            touched = {pos, (pos - 1 + sz) % sz, (pos + 1) % sz};
+        }
+        newMoves.clear();
+        generateMovesForNodes(touched, sol, unselected, distance, costs, restriction, newMoves, exchanges, false);
+        std::sort(newMoves.begin(), newMoves.end());
+        LM.erase(std::remove_if(LM.begin(), LM.end(), dead), LM.end());
+        size_t middle = LM.size();
+        LM.insert(LM.end(), newMoves.begin(), newMoves.end());
+        std::inplace_merge(LM.begin(), LM.begin() + middle, LM.end());
+    }
+    return sol;
+}
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> files;
+    int starts = 50;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--starts=", 0) == 0) {
+            starts = std::stoi(arg.substr(9));
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) files = {"input/TSPA.csv", "input/TSPB.csv"};
+
+    for (const std::string& filename : files) {
+        Instance instance = loadInstance(filename);
+        int n = instance.size();
+        if (n == 0) return 1;
+        int selectCount = (n + 1) / 2;
+        const DistanceMatrix& distance = instance.distance;
+        const std::vector<int>& costs = instance.costs;
+        std::vector<std::vector<int>> neighbors = buildNearestNeighbors(n, distance, costs, 10);
+
+        std::mt19937 rng(DEFAULT_SEED);
+        std::vector<std::vector<int>> initials;
+        for (int s = 0; s < starts; s++) initials.push_back(randomSolution(s % n, n, selectCount, rng));
+
+        std::cout << filename << " (n=" << n << ", " << starts << " random starts, avg per run)\n";
+        std::cout << "  " << std::left << std::setw(16) << "search" << std::right << std::setw(12) << "sorted obj"
+                  << std::setw(12) << "heap obj" << std::setw(12) << "sorted ms" << std::setw(12) << "heap ms"
+                  << std::setw(10) << "speedup" << std::setw(11) << "identical" << "\n";
+        for (bool candidates : {false, true}) {
+            double referenceMs = 0, heapMs = 0;
+            long long referenceObj = 0, heapObj = 0;
+            int identical = 0;
+            for (const auto& initial : initials) {
+                auto begin = std::chrono::high_resolution_clock::now();
+                std::vector<int> expected =
+                    candidates ? referenceMoveList(initial, distance, costs, n, CandidateNeighborhood{neighbors})
+                               : referenceMoveList(initial, distance, costs, n, FullNeighborhood());
+                referenceMs += elapsedMs(begin);
+
+                begin = std::chrono::high_resolution_clock::now();
+                std::vector<int> solution =
+                    candidates ? localSearchSteepestEdgesLMCandidates(initial, distance, costs, n, 10)
+                               : localSearchSteepestEdgesLM(initial, distance, costs, n);
+                heapMs += elapsedMs(begin);
+
+                referenceObj += calculateObjective(expected, distance, costs);
+                heapObj += calculateObjective(solution, distance, costs);
+                if (solution == expected) identical++;
+            }
+            std::cout << "  " << std::left << std::setw(16) << (candidates ? "LM Candidates" : "LM") << std::right
+                      << std::setw(12) << referenceObj / starts << std::setw(12) << heapObj / starts << std::fixed
+                      << std::setprecision(2) << std::setw(12) << referenceMs / starts << std::setw(12)
+                      << heapMs / starts << std::setprecision(1) << std::setw(9) << referenceMs / heapMs << "x"
+                      << std::setw(7) << identical << "/" << starts << "\n";
+        }
+        std::cout << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Weighted k-regret construction time versus greedyRegret2Weighted over all start nodes.
+// k = 2 must reproduce greedyRegret2Weighted exactly.
+//
+// Usage: ./benchmark.sh regretK [csv ...]
+//   defaults: input/TSPA.csv input/TSPB.csv
+// Exits with status 1 if the k = 2 tours differ.
+#include "../include/instance.h"
+#include "../include/calculateObjective.h"
+#include "../include/greedyRegret2Weighted.h"
+#include "../include/greedyRegretK.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <functional>
+#include <chrono>
+
+struct Sweep {
+    double avgMs = 0;
+    long long avgObjective = 0;
+    std::vector<std::vector<int>> tours;
+};
+
+static Sweep sweep(const Instance& instance, std::function<std::vector<int>(int, int)> construct) {
+    int n = instance.size();
+    int selectCount = (n + 1) / 2;
+    Sweep result;
+    double sumMs = 0;
+    long long sumObjective = 0;
+    for (int start = 0; start < n; start++) {
+        auto begin = std::chrono::high_resolution_clock::now();
+        result.tours.push_back(construct(start, selectCount));
+        auto end = std::chrono::high_resolution_clock::now();
+        sumMs += std::chrono::duration<double, std::milli>(end - begin).count();
+        sumObjective += calculateObjective(result.tours.back(), instance.distance, instance.costs);
+    }
+    result.avgMs = sumMs / n;
+    result.avgObjective = sumObjective / n;
+    return result;
+}
+
+static void print(const std::string& name, const Sweep& sweep, double baselineMs) {
+    std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << sweep.avgMs << " ms  x" << std::setprecision(2) << sweep.avgMs / baselineMs
+              << std::setw(12) << sweep.avgObjective << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; i++) files.push_back(argv[i]);
+    if (files.empty()) files = {"input/TSPA.csv", "input/TSPB.csv"};
+
+    bool identical = true;
+    for (const std::string& filename : files) {
+        Instance instance = loadInstance(filename);
+        if (instance.size() == 0) return 1;
+        const DistanceMatrix& distance = instance.distance;
+        const std::vector<int>& costs = instance.costs;
+        std::cout << filename << " (n=" << instance.size() << ", avg per construction, time relative to 2-regret, avg objective)\n";
+
+        Sweep baseline = sweep(instance, [&](int start, int selectCount) {
+            return greedyRegret2Weighted(start, selectCount, distance, costs, 1.0, 1.0);
+        });
+        print("greedyRegret2Weighted", baseline, baseline.avgMs);
+        for (int k = 2; k <= 5; k++) {
+            Sweep result = sweep(instance, [&](int start, int selectCount) {
+                return greedyRegretK(start, selectCount, distance, costs, k, 1.0, 1.0);
+            });
+            print("greedyRegretK k=" + std::to_string(k), result, baseline.avgMs);
+            if (k == 2 && result.tours != baseline.tours) {
+                std::cout << "  MISMATCH: k=2 differs from greedyRegret2Weighted\n";
+                identical = false;
+            }
+        }
+        std::cout << "\n";
+    }
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+// Weighted 2-regret constructors: the original full scan versus the insertion
+// cache + regret queue. Checks that both produce identical tours for every
+// start node on TSPA/TSPB and compares construction time.
+//
+// Usage: ./benchmark.sh regretQueue [csv ...]
+//   defaults: input/TSPA.csv input/TSPB.csv
+// Exits with status 1 if any tour differs.
+#include "../include/constants.h"
+#include "../include/instance.h"
+#include "../include/greedyRegret2Weighted.h"
+#include "../include/nearestNeighborAnyRegret2Weighted.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <functional>
+#include <chrono>
+#include <climits>
+#include <cmath>
+
+using Constructor = std::function<std::vector<int>(int, int, const DistanceMatrix&, const std::vector<int>&, double, double)>;
+
+// The scans both constructors used before (every node against every position, every step)
+static std::vector<int> referenceRegret(int startNode, int selectCount, const DistanceMatrix& distance,
+                                        const std::vector<int>& costs, double wRegret, double wBest, bool cycle) {
+    std::vector<int> solution;
+    std::vector<bool> selected(distance.size(), false);
+    solution.push_back(startNode);
+    selected[startNode] = true;
+    if (cycle && selectCount > 1) {
+        int bestNode = -1;
+        int bestDist = INT_MAX;
+        for (int i = 0; i < distance.size(); i++) {
+            if (selected[i]) continue;
+            int delta = distance[startNode][i] + costs[i];
+            if (delta < bestDist) { bestDist = delta; bestNode = i; }
+        }
+        solution.push_back(bestNode);
+        selected[bestNode] = true;
+    }
+    while (solution.size() < selectCount) {
+        int chooseNode = -1;
+        int choosePos = -1;
+        double bestScore = INIT_SCORE;
+        int tieBestDelta = INT_MAX;
+        int tieBestRegret = -1;
+        for (int i = 0; i < distance.size(); i++) {
+            if (selected[i]) continue;
+            int best1 = INT_MAX, best2 = INT_MAX;
+            int bestPos = -1;
+            int m = solution.size();
+            for (int pos = cycle ? 1 : 0; pos <= m; pos++) {
+                int delta = costs[i];
+                if (cycle || (pos > 0 && pos < m)) {
+                    int prev = solution[pos - 1], next = solution[pos % m];
+                    delta += distance[prev][i] + distance[i][next] - distance[prev][next];
+                } else if (pos == 0) {
+                    delta += distance[i][solution[0]];
+                } else {
+                    delta += distance[solution.back()][i];
+                }
+                if (delta < best1) {
+                    best2 = best1;
+                    best1 = delta;
+                    bestPos = pos;
+                } else if (delta < best2) {
+                    best2 = delta;
+                }
+            }
+            int regret = (best2 == INT_MAX ? 0 : (best2 - best1));
+            double score = wRegret * regret - wBest * best1;
+            if (score > bestScore || (std::abs(score - bestScore) < EPSILON && (best1 < tieBestDelta || (best1 == tieBestDelta && regret > tieBestRegret)))) {
+                bestScore = score;
+                tieBestDelta = best1;
+                tieBestRegret = regret;
+                chooseNode = i;
+                choosePos = bestPos;
+            }
+        }
+        solution.insert(solution.begin() + choosePos, chooseNode);
+        selected[chooseNode] = true;
+    }
+    return solution;
+}
+
+// Runs both versions from every start node; returns the number of differing tours
+static int compare(const std::string& name, const Instance& instance, Constructor reference, Constructor current,
+                   double wRegret, double wBest) {
+    int n = instance.size();
+    int selectCount = (n + 1) / 2;
+    double referenceMs = 0, currentMs = 0;
+    int mismatches = 0;
+    for (int start = 0; start < n; start++) {
+        auto t0 = std::chrono::high_resolution_clock::now();
+        std::vector<int> expected = reference(start, selectCount, instance.distance, instance.costs, wRegret, wBest);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        std::vector<int> actual = current(start, selectCount, instance.distance, instance.costs, wRegret, wBest);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        referenceMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+        currentMs += std::chrono::duration<double, std::milli>(t2 - t1).count();
+        if (actual != expected) mismatches++;
+    }
+    std::cout << "  " << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(3)
+              << " w=(" << std::setprecision(1) << wRegret << ", " << wBest << ")" << std::setprecision(3)
+              << std::setw(11) << referenceMs / n << " ms" << std::setw(11) << currentMs / n << " ms  x"
+              << std::setprecision(1) << referenceMs / currentMs
+              << (mismatches ? "  MISMATCH in " + std::to_string(mismatches) + " tours" : "  identical") << "\n";
+    return mismatches;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; i++) files.push_back(argv[i]);
+    if (files.empty()) files = {"input/TSPA.csv", "input/TSPB.csv"};
+
+    Constructor greedyReference = [](int s, int k, const DistanceMatrix& d, const std::vector<int>& c, double wr, double wb) {
+        return referenceRegret(s, k, d, c, wr, wb, true);
+    };
+    Constructor greedyCurrent = [](int s, int k, const DistanceMatrix& d, const std::vector<int>& c, double wr, double wb) {
+        return greedyRegret2Weighted(s, k, d, c, wr, wb);
+    };
+    Constructor nnAnyReference = [](int s, int k, const DistanceMatrix& d, const std::vector<int>& c, double wr, double wb) {
+        return referenceRegret(s, k, d, c, wr, wb, false);
+    };
+
+    int mismatches = 0;
+    for (const std::string& filename : files) {
+        Instance instance = loadInstance(filename);
+        if (instance.size() == 0) return 1;
+        std::cout << filename << " (n=" << instance.size() << ", avg per construction: scan, queue)\n";
+        for (auto [wRegret, wBest] : {std::pair{1.0, 1.0}, {1.0, 0.0}, {0.5, 2.0}}) {
+            mismatches += compare("greedyRegret2Weighted", instance, greedyReference, greedyCurrent, wRegret, wBest);
+            mismatches += compare("nearestNeighborAnyRegret2Weighted", instance, nnAnyReference,
+                                  nearestNeighborAnyRegret2Weighted, wRegret, wBest);
+        }
+        std::cout << "\n";
+    }
+    return mismatches ? 1 : 0;
+}
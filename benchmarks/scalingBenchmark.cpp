@@ -0,0 +1,200 @@
+// Time and memory of every algorithm in main.cpp versus instance size, on the
+// synthetic instances written by ./generate.sh (TSPA/TSPB, uniform/clustered).
+//
+// Usage: ./benchmark.sh scaling [n ...] [--starts=S] [--budget=SECONDS]
+//   defaults: n = 1000 10000 100000, 3 starts, 30 s budget
+// Each algorithm runs from S evenly spaced start nodes (MSLS, ILS and LNS once). Before moving to a larger
+// n, its time is extrapolated from the growth measured on the two previous sizes
+// (cubic if only one size is known) and it is skipped once that exceeds the budget.
+// MSLS uses 10 iterations instead of 200; ILS and LNS get the MSLS time as limit,
+// as in main.cpp. Results are also written to output/scaling.csv.
+#include "allocationCounter.h"
+#include "../include/constants.h"
+#include "../include/instance.h"
+#include "../include/calculateObjective.h"
+#include "../include/randomSolution.h"
+#include "../include/nearestNeighborEnd.h"
+#include "../include/nearestNeighborAny.h"
+#include "../include/greedyCycle.h"
+#include "../include/greedyRegret2.h"
+#include "../include/greedyRegret2Weighted.h"
+#include "../include/greedyRegretK.h"
+#include "../include/nearestNeighborAnyRegret2.h"
+#include "../include/nearestNeighborAnyRegret2Weighted.h"
+#include "../include/localSearch.h"
+#include "../include/candidateMoves.h"
+#include "../include/multipleStartLS.h"
+#include "../include/iteratedLS.h"
+#include "../include/largeNeighborhoodSearch.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <map>
+#include <random>
+#include <functional>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+
+constexpr int MSLS_ITERATIONS = 10;
+
+struct Algorithm {
+    std::string name;
+    std::function<std::vector<int>(int start, std::mt19937& rng)> run;
+    bool singleRun = false;   // MSLS/ILS/LNS: one run instead of one per start
+};
+
+struct Measurement {
+    double avgMs = 0;
+    double peakHeapMB = 0;
+    long long avgObjective = 0;
+};
+
+// Algorithms of main.cpp bound to one instance; start solutions for the local
+// searches are random (as for the "Random + ..." rows) or Greedy Weighted
+std::vector<Algorithm> algorithmsFor(const Instance& instance, double& mslsTime) {
+    const DistanceMatrix& distance = instance.distance;
+    const std::vector<int>& costs = instance.costs;
+    int n = instance.size();
+    int selectCount = (n + 1) / 2;
+    auto random = [=](int start, std::mt19937& rng) { return randomSolution(start, n, selectCount, rng); };
+    auto greedy = [=, &distance, &costs](int start) { return greedyRegret2Weighted(start, selectCount, distance, costs, 1.0, 1.0); };
+    auto initials = [=](int count, std::mt19937& rng) {
+        std::vector<std::vector<int>> result;
+        for (int i = 0; i < count; i++) result.push_back(randomSolution(i % n, n, selectCount, rng));
+        return result;
+    };
+    
+    return {
+        {"Random", random},
+        {"Nearest Neighbor (end only)", [=, &distance, &costs](int start, std::mt19937&) { return nearestNeighborEnd(start, selectCount, distance, costs); }},
+        {"Nearest Neighbor (any position)", [=, &distance, &costs](int start, std::mt19937&) { return nearestNeighborAny(start, selectCount, distance, costs); }},
+        {"Greedy Cycle", [=, &distance, &costs](int start, std::mt19937&) { return greedyCycle(start, selectCount, distance, costs); }},
+        {"Greedy 2-Regret", [=, &distance, &costs](int start, std::mt19937&) { return greedyRegret2(start, selectCount, distance, costs); }},
+        {"Greedy Weighted (2-Regret + BestDelta)", [=](int start, std::mt19937&) { return greedy(start); }},
+        {"Greedy Weighted (3-Regret + BestDelta)", [=, &distance, &costs](int start, std::mt19937&) { return greedyRegretK(start, selectCount, distance, costs, 3, 1.0, 1.0); }},
+        {"Nearest Neighbor Any 2-Regret", [=, &distance, &costs](int start, std::mt19937&) { return nearestNeighborAnyRegret2(start, selectCount, distance, costs); }},
+        {"Nearest Neighbor Any Weighted", [=, &distance, &costs](int start, std::mt19937&) { return nearestNeighborAnyRegret2Weighted(start, selectCount, distance, costs, 1.0, 1.0); }},
+        {"LS Random + Steepest + Nodes", [=, &distance, &costs](int start, std::mt19937& rng) { return localSearchSteepestNodes(random(start, rng), distance, costs, n); }},
+        {"LS Random + Steepest + Edges", [=, &distance, &costs](int start, std::mt19937& rng) { return localSearchSteepestEdges(random(start, rng), distance, costs, n); }},
+        {"LS Random + Greedy + Nodes", [=, &distance, &costs](int start, std::mt19937& rng) { return localSearchGreedyNodes(random(start, rng), distance, costs, n, rng); }},
+        {"LS Random + Greedy + Edges", [=, &distance, &costs](int start, std::mt19937& rng) { return localSearchGreedyEdges(random(start, rng), distance, costs, n, rng); }},
+        {"LS Greedy + Steepest + Edges", [=, &distance, &costs](int start, std::mt19937&) { return localSearchSteepestEdges(greedy(start), distance, costs, n); }},
+        {"LM Random + Steepest + Edges", [=, &distance, &costs](int start, std::mt19937& rng) { return localSearchSteepestEdgesLM(random(start, rng), distance, costs, n); }},
+        {"Candidates + Random + Steepest + Edges (k=10)", [=, &distance, &costs](int start, std::mt19937& rng) { return localSearchSteepestEdgesCandidates(random(start, rng), distance, costs, n, 10); }},
+        {"LM Candidates + Random + Steepest + Edges (k=10)", [=, &distance, &costs](int start, std::mt19937& rng) { return localSearchSteepestEdgesLMCandidates(random(start, rng), distance, costs, n, 10); }},
+        {"MSLS (" + std::to_string(MSLS_ITERATIONS) + " iterations)", [=, &distance, &costs, &mslsTime](int, std::mt19937& rng) {
+            auto start = std::chrono::high_resolution_clock::now();
+            auto result = multipleStartLS(n, selectCount, distance, costs, initials(MSLS_ITERATIONS, rng), MSLS_ITERATIONS, rng);
+            mslsTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            return result.bestSolution;
+        }, true},
+        {"ILS (MSLS time)", [=, &distance, &costs, &mslsTime](int, std::mt19937& rng) {
+            return iteratedLS(n, selectCount, distance, costs, initials(1, rng), mslsTime, rng).bestSolution;
+        }, true},
+        {"LNS with LS (MSLS time)", [=, &distance, &costs, &mslsTime](int, std::mt19937& rng) {
+            return largeNeighborhoodSearchWithLS(n, selectCount, distance, costs, initials(1, rng), mslsTime, rng).bestSolution;
+        }, true},
+        {"LNS without LS (MSLS time)", [=, &distance, &costs, &mslsTime](int, std::mt19937& rng) {
+            return largeNeighborhoodSearchNoLS(n, selectCount, distance, costs, initials(1, rng), mslsTime, rng).bestSolution;
+        }, true},
+    };
+}
+
+Measurement measure(const Algorithm& algorithm, const Instance& instance, int starts) {
+    std::mt19937 rng(DEFAULT_SEED);
+    if (algorithm.singleRun) starts = 1;
+    Measurement result;
+    size_t peak = 0;
+    double sumMs = 0;
+    long long sumObjective = 0;
+    for (int s = 0; s < starts; s++) {
+        int start = (int)((long long)s * instance.size() / starts);
+        allocationCounter::resetPeak();
+        size_t baseline = allocationCounter::liveBytes;
+        auto begin = std::chrono::high_resolution_clock::now();
+        std::vector<int> solution = algorithm.run(start, rng);
+        auto end = std::chrono::high_resolution_clock::now();
+        peak = std::max(peak, allocationCounter::peakBytes - baseline);
+        sumMs += std::chrono::duration<double, std::milli>(end - begin).count();
+        sumObjective += calculateObjective(solution, instance.distance, instance.costs);
+    }
+    result.avgMs = sumMs / starts;
+    result.peakHeapMB = peak / 1e6;
+    result.avgObjective = sumObjective / starts;
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes;
+    int starts = 3;
+    double budgetMs = 30000;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--starts=", 0) == 0) {
+            starts = std::stoi(arg.substr(9));
+        } else if (arg.rfind("--budget=", 0) == 0) {
+            budgetMs = std::stod(arg.substr(9)) * 1000;
+        } else {
+            sizes.push_back(std::stoi(arg));
+        }
+    }
+    if (sizes.empty()) sizes = {1000, 10000, 100000};
+    
+    std::filesystem::create_directories("output");
+    std::ofstream csv("output/scaling.csv");
+    csv << "instance,n,algorithm,avg_ms,peak_heap_mb,avg_objective\n";
+    
+    for (std::string variant : {"TSPA_uniform", "TSPA_clustered", "TSPB_uniform", "TSPB_clustered"}) {
+        // Per algorithm: (n, ms) of the sizes measured so far
+        std::map<std::string, std::vector<std::pair<int, double>>> history;
+        for (int n : sizes) {
+            std::string filename = "input/generated/" + variant + "_" + std::to_string(n) + ".csv";
+            if (!std::filesystem::exists(filename)) {
+                std::cout << filename << " not found, run ./generate.sh first\n";
+                continue;
+            }
+            Instance instance = loadInstance(filename);
+            std::cout << "\n=-=-= " << variant << " n=" << n << " (distances: "
+                      << (instance.distance.storage() == DistanceStorage::Lazy ? "lazy"
+                          : (instance.distance.storage() == DistanceStorage::Packed ? "packed, " : "full, ")
+                          + std::to_string(instance.distance.bytes() / 1000000) + " MB") << ") =-=-=\n";
+            std::cout << std::left << std::setw(50) << "algorithm" << std::right << std::setw(14) << "avg ms"
+                      << std::setw(14) << "peak heap MB" << std::setw(14) << "avg objective" << "\n";
+            
+            double mslsTime = 0;
+            for (const Algorithm& algorithm : algorithmsFor(instance, mslsTime)) {
+                auto& measured = history[algorithm.name];
+                if (!measured.empty()) {
+                    double exponent = 3;
+                    if (measured.size() >= 2) {
+                        auto [n0, t0] = measured[measured.size() - 2];
+                        auto [n1, t1] = measured.back();
+                        exponent = std::max(1.0, std::log(std::max(t1, 1e-3) / std::max(t0, 1e-3)) / std::log((double)n1 / n0));
+                    }
+                    double predicted = measured.back().second * std::pow((double)n / measured.back().first, exponent);
+                    if (measured.back().second < 0 || predicted > budgetMs) {
+                        std::cout << std::left << std::setw(50) << algorithm.name << std::right << "  skipped ";
+                        if (measured.back().second < 0) {
+                            std::cout << "(over budget at a smaller n)\n";
+                        } else {
+                            std::cout << "(~" << (int)(predicted / 1000) << " s per run)\n";
+                        }
+                        measured.push_back({n, -1});
+                        continue;
+                    }
+                }
+                Measurement m = measure(algorithm, instance, starts);
+                measured.push_back({n, m.avgMs});
+                std::cout << std::left << std::setw(50) << algorithm.name << std::right << std::fixed
+                          << std::setprecision(2) << std::setw(14) << m.avgMs << std::setprecision(3) << std::setw(14)
+                          << m.peakHeapMB << std::setw(14) << m.avgObjective << "\n" << std::flush;
+                csv << variant << "," << n << ",\"" << algorithm.name << "\"," << m.avgMs << ","
+                    << m.peakHeapMB << "," << m.avgObjective << "\n" << std::flush;
+            }
+        }
+    }
+    return 0;
+}
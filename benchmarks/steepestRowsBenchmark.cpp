@@ -0,0 +1,130 @@
+// Steepest nodes/edges local search: the original full scan of both
+// neighbourhoods every iteration versus the cached rows + MinTree. Checks
+// that both end in the same solution after the same number of moves from
+// every random start and compares time.
+//
+// Usage: ./benchmark.sh steepestRows [csv ...] [--starts=S]
+//   defaults: input/TSPA.csv input/TSPB.csv, 20 starts
+// Exits with status 1 if any run differs.
+#include "../include/constants.h"
+#include "../include/instance.h"
+#include "../include/randomSolution.h"
+#include "../include/localSearch.h"
+#include "../include/moveDeltas.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+// The loop both steepest searches used before: every pair, then every (position, node)
+static std::vector<int> referenceSteepest(const std::vector<int>& initialSolution, const DistanceMatrix& distance,
+                                          const std::vector<int>& costs, int n, bool edges, int& moves) {
+    std::vector<int> sol = initialSolution;
+    std::vector<bool> inSolution(n, false);
+    for (int node : sol) inSolution[node] = true;
+    moves = 0;
+    while (true) {
+        int bestDelta = 0, bestType = -1, bestPos1 = -1, bestPos2 = -1, bestNode = -1;
+        for (int i = 0; i < (int)sol.size(); i++) {
+            for (int j = i + 1; j < (int)sol.size(); j++) {
+                int delta = edges ? deltaReverseSegment(sol, i, j, distance) : deltaSwapNodes(sol, i, j, distance);
+                if (delta < bestDelta) {
+                    bestDelta = delta;
+                    bestType = 0;
+                    bestPos1 = i;
+                    bestPos2 = j;
+                }
+            }
+        }
+        for (int pos = 0; pos < (int)sol.size(); pos++) {
+            for (int node = 0; node < n; node++) {
+                if (inSolution[node]) continue;
+                int delta = deltaExchangeNodes(sol, pos, node, distance, costs);
+                if (delta < bestDelta) {
+                    bestDelta = delta;
+                    bestType = 1;
+                    bestPos1 = pos;
+                    bestNode = node;
+                }
+            }
+        }
+        if (bestDelta >= 0) break;
+        moves++;
+        if (bestType == 0) {
+            if (edges) {
+                std::reverse(sol.begin() + bestPos1 + 1, sol.begin() + bestPos2 + 1);
+            } else {
+                std::swap(sol[bestPos1], sol[bestPos2]);
+            }
+        } else {
+            inSolution[sol[bestPos1]] = false;
+            inSolution[bestNode] = true;
+            sol[bestPos1] = bestNode;
+        }
+    }
+    return sol;
+}
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> files;
+    int starts = 20;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--starts=", 0) == 0) {
+            starts = std::stoi(arg.substr(9));
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) files = {"input/TSPA.csv", "input/TSPB.csv"};
+
+    int mismatches = 0;
+    for (const std::string& filename : files) {
+        Instance instance = loadInstance(filename);
+        int n = instance.size();
+        if (n == 0) return 1;
+        int selectCount = (n + 1) / 2;
+        const DistanceMatrix& distance = instance.distance;
+        const std::vector<int>& costs = instance.costs;
+
+        std::mt19937 rng(DEFAULT_SEED);
+        std::vector<std::vector<int>> initials;
+        for (int s = 0; s < starts; s++) initials.push_back(randomSolution(s % n, n, selectCount, rng));
+
+        std::cout << filename << " (n=" << n << ", " << starts << " random starts, avg ms per run)\n";
+        std::cout << "  " << std::left << std::setw(18) << "local search" << std::right << std::setw(10) << "moves"
+                  << std::setw(12) << "full scan" << std::setw(12) << "rows" << std::setw(10) << "speedup" << "\n";
+        for (bool edges : {false, true}) {
+            double referenceMs = 0, rowsMs = 0, sumMoves = 0;
+            int differing = 0;
+            for (const auto& initial : initials) {
+                int moves = 0;
+                auto begin = std::chrono::high_resolution_clock::now();
+                std::vector<int> expected = referenceSteepest(initial, distance, costs, n, edges, moves);
+                referenceMs += elapsedMs(begin);
+                sumMoves += moves;
+
+                begin = std::chrono::high_resolution_clock::now();
+                std::vector<int> solution = edges ? localSearchSteepestEdges(initial, distance, costs, n)
+                                                  : localSearchSteepestNodes(initial, distance, costs, n);
+                rowsMs += elapsedMs(begin);
+                if (solution != expected) differing++;
+            }
+            mismatches += differing;
+            std::cout << "  " << std::left << std::setw(18) << (edges ? "Steepest Edges" : "Steepest Nodes")
+                      << std::right << std::fixed << std::setprecision(0) << std::setw(10) << sumMoves / starts
+                      << std::setprecision(2) << std::setw(12) << referenceMs / starts << std::setw(12) << rowsMs / starts
+                      << std::setprecision(1) << std::setw(9) << referenceMs / rowsMs << "x"
+                      << (differing ? "  MISMATCH in " + std::to_string(differing) + " runs" : "  identical") << "\n";
+        }
+        std::cout << "\n";
+    }
+    return mismatches ? 1 : 0;
+}
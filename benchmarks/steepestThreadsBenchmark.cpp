@@ -0,0 +1,92 @@
+// Steepest edges/nodes local search on large generated instances with the
+// row passes split across 1..T threads (LSWorkspace::setThreads). Checks that
+// every thread count ends in the same solution as one thread and writes the
+// times to output/steepestThreads.csv for the scaling chart.
+//
+// Usage: ./benchmark.sh steepestThreads [n ...] [--threads=1,2,4,...] [--starts=S]
+//   defaults: n = 5000 20000, threads 1,2,4,8,16,32, 1 start
+// Instances are input/generated/TSPA_uniform_<n>.csv; make missing ones with
+// ./generate.sh input/generated <n>. Exits with status 1 if any solution differs.
+#include "../include/constants.h"
+#include "../include/instance.h"
+#include "../include/randomSolution.h"
+#include "../include/localSearch.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <filesystem>
+
+int main(int argc, char* argv[]) {
+    std::vector<int> sizes;
+    std::vector<int> threadCounts = {1, 2, 4, 8, 16, 32};
+    int starts = 1;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--threads=", 0) == 0) {
+            threadCounts.clear();
+            std::stringstream list(arg.substr(10));
+            for (std::string item; std::getline(list, item, ',');) threadCounts.push_back(std::stoi(item));
+        } else if (arg.rfind("--starts=", 0) == 0) {
+            starts = std::stoi(arg.substr(9));
+        } else {
+            sizes.push_back(std::stoi(arg));
+        }
+    }
+    if (sizes.empty()) sizes = {5000, 20000};
+
+    std::filesystem::create_directories("output");
+    std::ofstream csv("output/steepestThreads.csv");
+    csv << "instance,search,threads,ms,speedup\n";
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << "\n";
+
+    int mismatches = 0;
+    for (int size : sizes) {
+        std::string filename = "input/generated/TSPA_uniform_" + std::to_string(size) + ".csv";
+        Instance instance = loadInstance(filename);
+        int n = instance.size();
+        if (n == 0) return 1;
+        int selectCount = (n + 1) / 2;
+        std::mt19937 rng(DEFAULT_SEED);
+        std::vector<std::vector<int>> initials;
+        for (int s = 0; s < starts; s++) initials.push_back(randomSolution(s % n, n, selectCount, rng));
+
+        std::cout << filename << " (n=" << n << ", " << starts << " starts, total ms)\n";
+        std::cout << "  " << std::left << std::setw(16) << "search" << std::right << std::setw(8) << "threads"
+                  << std::setw(12) << "ms" << std::setw(10) << "speedup" << "\n";
+        for (bool edges : {true, false}) {
+            const char* name = edges ? "SteepestEdges" : "SteepestNodes";
+            std::vector<std::vector<int>> expected;
+            double singleMs = 0;
+            for (int threads : threadCounts) {
+                LSWorkspace workspace(n);
+                workspace.setThreads(threads);
+                std::vector<std::vector<int>> solutions;
+                auto begin = std::chrono::high_resolution_clock::now();
+                for (const std::vector<int>& initial : initials) {
+                    solutions.push_back(edges ? localSearchSteepestEdges(initial, instance.distance, instance.costs, n, workspace)
+                                              : localSearchSteepestNodes(initial, instance.distance, instance.costs, n, workspace));
+                }
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+                if (expected.empty()) {
+                    expected = solutions;
+                    singleMs = ms;
+                }
+                bool same = solutions == expected;
+                if (!same) mismatches++;
+                std::cout << "  " << std::left << std::setw(16) << name << std::right << std::setw(8) << threads
+                          << std::fixed << std::setprecision(1) << std::setw(12) << ms << std::setw(9)
+                          << singleMs / ms << "x" << (same ? "" : "  DIFFERS") << "\n";
+                csv << std::filesystem::path(filename).stem().string() << "," << name << "," << threads << ","
+                    << ms << "," << singleMs / ms << "\n";
+            }
+        }
+        std::cout << "\n";
+    }
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,176 @@
+// Random 2-opt moves and node replacements applied to an array tour (reversing
+// the shorter side) and to a TwoLevelTour, for growing tour sizes. Checks after
+// every batch that both hold the same cycle and that next/prev/between agree,
+// and counts the heap allocations of the timed two-level moves.
+//
+// Usage: ./benchmark.sh twoLevelTour [--moves=M] [sizes ...]
+//   defaults: M = 200000, sizes 100 1000 5000 20000 100000
+// Exits with status 1 if the tours ever differ or a two-level move allocates.
+#include "allocationCounter.h"
+#include "../include/constants.h"
+#include "../include/twoLevelTour.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <numeric>
+#include <algorithm>
+
+struct ArrayTour {
+    std::vector<int> sol, pos;
+
+    int next(int node) const { return sol[(pos[node] + 1) % sol.size()]; }
+
+    void twoOptMove(int a, int c) {
+        int m = sol.size();
+        int i = pos[a], j = pos[c];
+        if (i > j) std::swap(i, j);
+        int from = i + 1, length = j - i;
+        if (2 * length > m) {
+            from = j + 1;
+            length = m - length;
+        }
+        for (int p = 0, q = length - 1; p < q; p++, q--) {
+            int x = (from + p) % m, y = (from + q) % m;
+            std::swap(sol[x], sol[y]);
+            pos[sol[x]] = x;
+            pos[sol[y]] = y;
+        }
+    }
+};
+
+// Successor of every node; equal for both tours up to the direction of the cycle
+static bool sameCycle(const ArrayTour& array, const TwoLevelTour& twoLevel, const std::vector<int>& sample) {
+    int first = array.sol[0];
+    bool forward = twoLevel.next(first) == array.next(first);
+    for (int node : array.sol) {
+        int expected = array.next(node);
+        if ((forward ? twoLevel.next(node) : twoLevel.prev(node)) != expected) return false;
+        if ((forward ? twoLevel.prev(expected) : twoLevel.next(expected)) != node) return false;
+    }
+    // between(a, b, c) against positions in the array
+    for (size_t s = 0; s + 2 < sample.size(); s += 3) {
+        int a = sample[s], b = sample[s + 1], c = sample[s + 2];
+        int m = array.sol.size();
+        int ab = (array.pos[b] - array.pos[a] + m) % m, ac = (array.pos[c] - array.pos[a] + m) % m;
+        bool expected = forward ? ab <= ac : (m - ab) % m <= (m - ac) % m;
+        if (twoLevel.between(a, b, c) != expected) return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int moves = 200000;
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--moves=", 0) == 0) {
+            moves = std::stoi(arg.substr(8));
+        } else {
+            sizes.push_back(std::stoi(arg));
+        }
+    }
+    if (sizes.empty()) sizes = {100, 1000, 5000, 20000, 100000};
+
+    std::cout << "Random 2-opt moves (" << moves << " per size, us per move)\n";
+    std::cout << "  " << std::right << std::setw(8) << "m" << std::setw(12) << "array" << std::setw(12) << "two-level"
+              << std::setw(10) << "speedup" << std::setw(10) << "allocs" << "\n";
+    bool failed = false;
+    for (int m : sizes) {
+        // Tour of m nodes out of 2m, the rest available for replacements
+        int n = 2 * m;
+        std::mt19937 rng(DEFAULT_SEED);
+        std::vector<int> nodes(n);
+        std::iota(nodes.begin(), nodes.end(), 0);
+        std::shuffle(nodes.begin(), nodes.end(), rng);
+        std::vector<int> outside(nodes.begin() + m, nodes.end());
+        nodes.resize(m);
+
+        ArrayTour array{nodes, std::vector<int>(n, -1)};
+        for (int i = 0; i < m; i++) array.pos[nodes[i]] = i;
+        TwoLevelTour twoLevel(n);
+        twoLevel.reset(nodes);
+
+        // Same move sequence for both: pairs of tour nodes, and every 8th move a replacement
+        std::vector<int> a(moves), c(moves);
+        std::uniform_int_distribution<int> pick(0, m - 1);
+        for (int i = 0; i < moves; i++) {
+            a[i] = pick(rng);
+            c[i] = pick(rng);
+        }
+
+        double arrayMs = 0, twoLevelMs = 0;
+        size_t allocations = 0;
+        int batch = std::max(1, moves / 20);
+        std::uniform_int_distribution<int> pickOutside(0, (int)outside.size() - 1);
+        for (int begin = 0; begin < moves && !failed; begin += batch) {
+            int end = std::min(moves, begin + batch);
+            // Map indices to nodes through the array before timing
+            std::vector<int> from(end - begin), to(end - begin);
+            for (int i = begin; i < end; i++) {
+                from[i - begin] = array.sol[a[i]];
+                to[i - begin] = array.sol[c[i]];
+            }
+
+            // Successors in the array's direction, to replay the same edge exchange on the
+            // two-level tour, whose direction may differ after reversing a complement
+            std::vector<int> fromNext(end - begin, -1), toNext(end - begin, -1);
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < end - begin; i++) {
+                if (from[i] != to[i] && array.next(from[i]) != to[i] && array.next(to[i]) != from[i]) {
+                    fromNext[i] = array.next(from[i]);
+                    toNext[i] = array.next(to[i]);
+                    array.twoOptMove(from[i], to[i]);
+                }
+            }
+            arrayMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+            size_t before = allocationCounter::allocations;
+            start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < end - begin; i++) {
+                if (fromNext[i] < 0) continue;
+                if (twoLevel.next(from[i]) == fromNext[i]) {
+                    twoLevel.twoOptMove(from[i], to[i]);
+                } else {
+                    twoLevel.twoOptMove(fromNext[i], toNext[i]);
+                }
+            }
+            twoLevelMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            allocations += allocationCounter::allocations - before;
+
+            // A few replacements, outside the timing
+            for (int r = 0; r < 8; r++) {
+                int index = pickOutside(rng);
+                int oldNode = array.sol[pick(rng)], newNode = outside[index];
+                outside[index] = oldNode;
+                array.sol[array.pos[oldNode]] = newNode;
+                array.pos[newNode] = array.pos[oldNode];
+                array.pos[oldNode] = -1;
+                twoLevel.replace(oldNode, newNode);
+            }
+
+            std::vector<int> sample(30);
+            for (int& node : sample) node = array.sol[pick(rng)];
+            if (!sameCycle(array, twoLevel, sample)) failed = true;
+        }
+        if (!failed) {
+            std::vector<int> flat = twoLevel.toVector();
+            std::vector<int> sorted = flat, expected = array.sol;
+            std::sort(sorted.begin(), sorted.end());
+            std::sort(expected.begin(), expected.end());
+            if ((int)flat.size() != m || sorted != expected) failed = true;
+        }
+
+        std::cout << "  " << std::setw(8) << m << std::fixed << std::setprecision(3)
+                  << std::setw(12) << 1000 * arrayMs / moves << std::setw(12) << 1000 * twoLevelMs / moves
+                  << std::setprecision(1) << std::setw(9) << arrayMs / twoLevelMs << "x" << std::setw(10) << allocations
+                  << (failed ? "  MISMATCH" : "  identical") << (allocations > 0 ? "  ALLOCATES" : "") << "\n";
+        if (failed || allocations > 0) {
+            failed = true;
+            break;
+        }
+    }
+    return failed ? 1 : 0;
+}
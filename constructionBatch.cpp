@@ -0,0 +1,12 @@
+#include "include/constructionBatch.h"
+#include <numeric>
+
+int batchThreads(const DistanceMatrix& distance, int requested) {
+    return distance.storage() == DistanceStorage::Lazy ? 1 : std::max(1, requested);
+}
+
+std::vector<int> allStarts(int n) {
+    std::vector<int> starts(n);
+    std::iota(starts.begin(), starts.end(), 0);
+    return starts;
+}
@@ -0,0 +1,162 @@
+#include "include/distanceMatrix.h"
+#include <cmath>
+#include <algorithm>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+void computeDistanceRow(int i, const int* xs, const int* ys, int n, int32_t* out) {
+    int j = 0;
+#ifdef __AVX2__
+    // Squares of integer coordinates are exact in double, and sqrt of an integer is
+    // never exactly k + 0.5, so round-to-nearest matches round() bit for bit
+    __m256d xi = _mm256_set1_pd(xs[i]);
+    __m256d yi = _mm256_set1_pd(ys[i]);
+    for (; j + 4 <= n; j += 4) {
+        __m256d dx = _mm256_sub_pd(xi, _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(xs + j))));
+        __m256d dy = _mm256_sub_pd(yi, _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ys + j))));
+        __m256d d = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+        d = _mm256_round_pd(d, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + j), _mm256_cvtpd_epi32(d));
+    }
+#endif
+    for (; j < n; j++) {
+        double dx = xs[i] - xs[j];
+        double dy = ys[i] - ys[j];
+        out[j] = round(sqrt(dx * dx + dy * dy));
+    }
+}
+
+int LazyDistances::miss(int i, int j) {
+    if (capacity > 0 && ++misses[i] >= admitThreshold) {
+        return loadRow(i)[j];
+    }
+    double dx = xs[i] - xs[j];
+    double dy = ys[i] - ys[j];
+    return round(sqrt(dx * dx + dy * dy));
+}
+
+const int32_t* LazyDistances::loadRow(int i) {
+    int slot = slotOf[i];
+    if (slot < 0) {
+        // Free slot if any, otherwise evict the least recently used row
+        slot = 0;
+        for (int s = 0; s < capacity; s++) {
+            if (rowOfSlot[s] < 0) {
+                slot = s;
+                break;
+            }
+            if (lastUse[s] < lastUse[slot]) slot = s;
+        }
+        if (rowOfSlot[slot] >= 0) slotOf[rowOfSlot[slot]] = -1;
+        rowOfSlot[slot] = i;
+        slotOf[i] = slot;
+        misses[i] = 0;
+        computeDistanceRow(i, xs.data(), ys.data(), n, rows.data() + (size_t)slot * n);
+    }
+    lastUse[slot] = ++tick;
+    return rows.data() + (size_t)slot * n;
+}
+
+DistanceMatrix::DistanceMatrix(int n, DistanceWidth width, DistanceStorage storage)
+    : n(n), elementWidth(width), storageKind(storage) {
+    auto buffer = std::make_shared<std::vector<int32_t>>((bytes() + 3) / 4, 0);
+    elements = buffer->data();
+    owner = buffer;
+}
+
+DistanceMatrix DistanceMatrix::view(int n, DistanceWidth width, DistanceStorage storage,
+                                    const void* elements, std::shared_ptr<const void> owner) {
+    DistanceMatrix matrix;
+    matrix.n = n;
+    matrix.elementWidth = width;
+    matrix.storageKind = storage;
+    matrix.elements = elements;
+    matrix.owner = std::move(owner);
+    return matrix;
+}
+
+DistanceWidth DistanceMatrix::widthFor(const std::vector<int>& xs, const std::vector<int>& ys) {
+    // The largest distance is bounded by the diagonal of the bounding box
+    if (xs.empty()) return DistanceWidth::Int16;
+    auto [minX, maxX] = std::minmax_element(xs.begin(), xs.end());
+    auto [minY, maxY] = std::minmax_element(ys.begin(), ys.end());
+    double dx = (double)*maxX - *minX;
+    double dy = (double)*maxY - *minY;
+    double diagonal = round(sqrt(dx * dx + dy * dy));
+    return diagonal <= INT16_MAX ? DistanceWidth::Int16 : DistanceWidth::Int32;
+}
+
+DistanceMatrix DistanceMatrix::fromCoordinates(const std::vector<int>& xs, const std::vector<int>& ys) {
+    return fromCoordinates(xs, ys, widthFor(xs, ys));
+}
+
+DistanceMatrix DistanceMatrix::fromCoordinates(const std::vector<int>& xs, const std::vector<int>& ys, DistanceWidth width) {
+    int n = xs.size();
+    DistanceMatrix matrix(n, width);
+    std::vector<int32_t> row(n);
+    for (int i = 0; i < n; i++) {
+        computeDistanceRow(i, xs.data(), ys.data(), n, row.data());
+        for (int j = 0; j < n; j++) {
+            matrix.set(i, j, row[j]);
+        }
+    }
+    matrix.attachCoordinates(xs, ys);
+    return matrix;
+}
+
+DistanceMatrix DistanceMatrix::packed(const std::vector<int>& xs, const std::vector<int>& ys) {
+    return packed(xs, ys, widthFor(xs, ys));
+}
+
+DistanceMatrix DistanceMatrix::packed(const std::vector<int>& xs, const std::vector<int>& ys, DistanceWidth width) {
+    int n = xs.size();
+    DistanceMatrix matrix(n, width, DistanceStorage::Packed);
+    std::vector<int32_t> row(n);
+    for (int i = 0; i < n; i++) {
+        // Column i of the upper triangle is d(0..i, i)
+        computeDistanceRow(i, xs.data(), ys.data(), i + 1, row.data());
+        for (int j = 0; j <= i; j++) {
+            matrix.set(j, i, row[j]);
+        }
+    }
+    matrix.attachCoordinates(xs, ys);
+    return matrix;
+}
+
+DistanceMatrix DistanceMatrix::lazy(const std::vector<int>& xs, const std::vector<int>& ys, int cacheRows) {
+    int n = xs.size();
+    auto state = std::make_shared<LazyDistances>();
+    state->n = n;
+    state->xs = xs;
+    state->ys = ys;
+    state->capacity = std::max(0, std::min(cacheRows, n));
+    state->admitThreshold = std::max(1, n / LazyDistances::LAZY_ADMIT_RATIO);
+    state->slotOf.assign(n, -1);
+    state->rowOfSlot.assign(state->capacity, -1);
+    state->lastUse.assign(state->capacity, 0);
+    state->rows.resize((size_t)state->capacity * n);
+    state->misses.assign(n, 0);
+
+    DistanceMatrix matrix;
+    matrix.n = n;
+    matrix.elementWidth = DistanceWidth::Int32;
+    matrix.storageKind = DistanceStorage::Lazy;
+    matrix.lazyState = state;
+    matrix.attachCoordinates(xs, ys);
+    return matrix;
+}
+
+void DistanceMatrix::attachCoordinates(const std::vector<int>& xs, const std::vector<int>& ys) {
+    coordinates = std::make_shared<const Coordinates>(Coordinates{xs, ys});
+}
+
+void DistanceMatrix::set(int i, int j, int value) {
+    size_t offset = storageKind == DistanceStorage::Packed ? packedIndex(i, j) : (size_t)i * n + j;
+    // Only called while building an owned matrix
+    if (elementWidth == DistanceWidth::Int16) {
+        static_cast<int16_t*>(const_cast<void*>(elements))[offset] = (int16_t)value;
+    } else {
+        static_cast<int32_t*>(const_cast<void*>(elements))[offset] = value;
+    }
+}
@@ -0,0 +1,64 @@
+#include "include/edgeGrid.h"
+#include <cmath>
+
+EdgeGrid::EdgeGrid(const std::vector<int>& xs, const std::vector<int>& ys, int cellCount)
+    : xs(xs), ys(ys) {
+    int n = xs.size();
+    cellOf.assign(n, NONE);
+    nextInCell.assign(n, NONE);
+    prevInCell.assign(n, NONE);
+    edgeLength.assign(n, 0);
+    if (n == 0) {
+        cellHead.assign(1, NONE);
+        return;
+    }
+    auto [loX, hiX] = std::minmax_element(xs.begin(), xs.end());
+    auto [loY, hiY] = std::minmax_element(ys.begin(), ys.end());
+    minX = *loX;
+    minY = *loY;
+    double extentX = (double)*hiX - *loX;
+    double extentY = (double)*hiY - *loY;
+    // Square cells, about cellCount of them over the bounding box
+    side = std::sqrt(std::max(extentX * extentY, std::max(extentX, extentY)) / std::max(1, cellCount));
+    side = std::max(side, 1.0);
+    width = (int)(extentX / side) + 1;
+    height = (int)(extentY / side) + 1;
+    cellHead.assign((size_t)width * height, NONE);
+    // Rounded distances never exceed the rounded bounding box diagonal
+    lengthCount.assign((int)std::ceil(std::sqrt(extentX * extentX + extentY * extentY)) + 2, 0);
+}
+
+void EdgeGrid::clear() {
+    std::fill(cellHead.begin(), cellHead.end(), NONE);
+    std::fill(cellOf.begin(), cellOf.end(), NONE);
+    std::fill(lengthCount.begin(), lengthCount.end(), 0);
+    longest = 0;
+}
+
+void EdgeGrid::place(int edge, int a, int b, int length) {
+    remove(edge);
+    int cell = cellY((ys[a] + (double)ys[b]) / 2) * width + cellX((xs[a] + (double)xs[b]) / 2);
+    cellOf[edge] = cell;
+    prevInCell[edge] = NONE;
+    nextInCell[edge] = cellHead[cell];
+    if (cellHead[cell] != NONE) prevInCell[cellHead[cell]] = edge;
+    cellHead[cell] = edge;
+    edgeLength[edge] = length;
+    if (length >= (int)lengthCount.size()) lengthCount.resize(length + 1, 0);
+    lengthCount[length]++;
+    longest = std::max(longest, length);
+}
+
+void EdgeGrid::remove(int edge) {
+    int cell = cellOf[edge];
+    if (cell == NONE) return;
+    if (prevInCell[edge] != NONE) {
+        nextInCell[prevInCell[edge]] = nextInCell[edge];
+    } else {
+        cellHead[cell] = nextInCell[edge];
+    }
+    if (nextInCell[edge] != NONE) prevInCell[nextInCell[edge]] = prevInCell[edge];
+    cellOf[edge] = NONE;
+    lengthCount[edgeLength[edge]]--;
+    while (longest > 0 && lengthCount[longest] == 0) longest--;
+}
@@ -0,0 +1,156 @@
+#include "include/exchangeScan.h"
+#include <algorithm>
+#include <climits>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+ExchangeCandidates::ExchangeCandidates(const std::vector<bool>& inSolution, const std::vector<int>& costs) {
+    reset(inSolution, costs);
+}
+
+void ExchangeCandidates::reset(const std::vector<bool>& inSolution, const std::vector<int>& costs) {
+    costTable = &costs;
+    nodeList.clear();
+    costList.clear();
+    for (int node = 0; node < (int)inSolution.size(); node++) {
+        if (inSolution[node]) continue;
+        nodeList.push_back(node);
+        costList.push_back(costs[node]);
+    }
+}
+
+void ExchangeCandidates::exchange(int oldNode, int newNode) {
+    auto at = std::lower_bound(nodeList.begin(), nodeList.end(), newNode);
+    costList.erase(costList.begin() + (at - nodeList.begin()));
+    nodeList.erase(at);
+    at = std::lower_bound(nodeList.begin(), nodeList.end(), oldNode);
+    costList.insert(costList.begin() + (at - nodeList.begin()), (*costTable)[oldNode]);
+    nodeList.insert(at, oldNode);
+}
+
+#ifdef __AVX2__
+namespace {
+
+// d(prev, v) + d(v, next) + cost(v) for eight consecutive candidates of a full matrix
+class InsertionLanes {
+public:
+    InsertionLanes(const DistanceMatrix& distance, int prev, int next)
+        : narrow(distance.width() == DistanceWidth::Int16) {
+        if (narrow) {
+            prevRow = reinterpret_cast<const int*>(distance.row16(prev));
+            nextRow = reinterpret_cast<const int*>(distance.row16(next));
+        } else {
+            prevRow = distance.row32(prev);
+            nextRow = distance.row32(next);
+        }
+    }
+
+    // False where the gathers cannot be used: other storage, or 32-bit gathers at
+    // 2-byte offsets from the last row, which would read past the matrix
+    static bool available(const DistanceMatrix& distance, int prev, int next) {
+        if (distance.storage() != DistanceStorage::Full) return false;
+        if (distance.width() == DistanceWidth::Int32) return true;
+        return prev + 1 < distance.size() && next + 1 < distance.size();
+    }
+
+    __m256i operator()(const int* nodes, const int* nodeCosts) const {
+        __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nodes));
+        __m256i cost = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nodeCosts));
+        __m256i toPrev, toNext;
+        if (narrow) {
+            __m256i low = _mm256_set1_epi32(0xFFFF);
+            toPrev = _mm256_and_si256(_mm256_i32gather_epi32(prevRow, index, 2), low);
+            toNext = _mm256_and_si256(_mm256_i32gather_epi32(nextRow, index, 2), low);
+        } else {
+            toPrev = _mm256_i32gather_epi32(prevRow, index, 4);
+            toNext = _mm256_i32gather_epi32(nextRow, index, 4);
+        }
+        return _mm256_add_epi32(_mm256_add_epi32(toPrev, toNext), cost);
+    }
+
+private:
+    bool narrow;
+    const int* prevRow;
+    const int* nextRow;
+};
+
+}
+#endif
+
+ExchangeDelta bestExchange(const ExchangeCandidates& candidates, int prev, int next, int removed,
+                           const DistanceMatrix& distance) {
+    const int* nodes = candidates.nodes();
+    const int* nodeCosts = candidates.nodeCosts();
+    int count = candidates.size();
+    int best = INT_MAX, bestIndex = -1;
+    int i = 0;
+#ifdef __AVX2__
+    if (InsertionLanes::available(distance, prev, next)) {
+        // Per lane the first smallest value and its index, reduced in index order below
+        InsertionLanes lanes(distance, prev, next);
+        __m256i bestValue = _mm256_set1_epi32(INT_MAX);
+        __m256i bestAt = _mm256_set1_epi32(-1);
+        __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        __m256i eight = _mm256_set1_epi32(8);
+        for (; i + 8 <= count; i += 8) {
+            __m256i value = lanes(nodes + i, nodeCosts + i);
+            __m256i better = _mm256_cmpgt_epi32(bestValue, value);
+            bestValue = _mm256_blendv_epi8(bestValue, value, better);
+            bestAt = _mm256_blendv_epi8(bestAt, index, better);
+            index = _mm256_add_epi32(index, eight);
+        }
+        alignas(32) int32_t values[8], at[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(values), bestValue);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(at), bestAt);
+        for (int lane = 0; lane < 8; lane++) {
+            if (at[lane] < 0) continue;
+            if (values[lane] < best || (values[lane] == best && at[lane] < bestIndex)) {
+                best = values[lane];
+                bestIndex = at[lane];
+            }
+        }
+    }
+#endif
+    DistanceMatrix::Row prevRow = distance[prev], nextRow = distance[next];
+    for (; i < count; i++) {
+        int value = prevRow[nodes[i]] + nextRow[nodes[i]] + nodeCosts[i];
+        if (value < best) {
+            best = value;
+            bestIndex = i;
+        }
+    }
+    if (bestIndex < 0) return {-1, INT_MAX};
+    return {nodes[bestIndex], best - removed};
+}
+
+void improvingExchanges(const ExchangeCandidates& candidates, int prev, int next, int removed,
+                        const DistanceMatrix& distance, std::vector<ExchangeDelta>& moves) {
+    const int* nodes = candidates.nodes();
+    const int* nodeCosts = candidates.nodeCosts();
+    int count = candidates.size();
+    int i = 0;
+#ifdef __AVX2__
+    if (InsertionLanes::available(distance, prev, next)) {
+        // Only lanes below removed (delta < 0) are stored, in lane order
+        InsertionLanes lanes(distance, prev, next);
+        __m256i threshold = _mm256_set1_epi32(removed);
+        alignas(32) int32_t values[8];
+        for (; i + 8 <= count; i += 8) {
+            __m256i value = lanes(nodes + i, nodeCosts + i);
+            int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(threshold, value)));
+            if (mask == 0) continue;
+            _mm256_store_si256(reinterpret_cast<__m256i*>(values), value);
+            for (; mask; mask &= mask - 1) {
+                int lane = __builtin_ctz(mask);
+                moves.push_back({nodes[i + lane], values[lane] - removed});
+            }
+        }
+    }
+#endif
+    DistanceMatrix::Row prevRow = distance[prev], nextRow = distance[next];
+    for (; i < count; i++) {
+        int delta = prevRow[nodes[i]] + nextRow[nodes[i]] + nodeCosts[i] - removed;
+        if (delta < 0) moves.push_back({nodes[i], delta});
+    }
+}
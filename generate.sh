@@ -0,0 +1,4 @@
+# Usage: ./generate.sh [outputDir] [n ...]   (builds tools/instanceGenerator.cpp and writes synthetic instances)
+g++ -std=c++17 -O2 -march=native -I. \
+    tools/instanceGenerator.cpp \
+    -o tools/instanceGenerator && ./tools/instanceGenerator "$@"
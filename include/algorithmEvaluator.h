@@ -6,6 +6,9 @@
 #include <functional>
 #include <climits>
 #include <cfloat>
+#include "distanceMatrix.h"
+#include "constructionBatch.h"
+#include "localSearchCounters.h"
 
 struct AlgorithmResult {
     int minObj;
@@ -15,18 +18,24 @@ struct AlgorithmResult {
     double maxTime;
     double avgTime;
     std::vector<int> bestSolution;
+    LSCounters counters;   // local search moves over all runs, zero unless built with -DLS_COUNTERS
 };
 
 AlgorithmResult evaluateAlgorithm(
     const std::string& name,
     int n,
     int selectCount,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     std::function<std::vector<int>(int)> algorithmFunc
 );
 
-void printAlgorithmResult(const std::string& name, const AlgorithmResult& result);
+// Same statistics for solutions already built by a batch constructor
+AlgorithmResult evaluateBatch(const BatchSolutions& batch, const DistanceMatrix& distance, const std::vector<int>& costs);
+
+// originalIds maps renumbered nodes back to CSV rows for the "Best:" line (empty: no renumbering)
+void printAlgorithmResult(const std::string& name, const AlgorithmResult& result,
+                          const std::vector<int>& originalIds = {});
 
 // Evaluator for iterative algorithms (MSLS, ILS) that run a fixed number of times
 // Function should return a struct with: bestSolution, bestObjective, totalTime
@@ -43,6 +52,7 @@ AlgorithmResult evaluateIterativeAlgorithm(
     result.maxTime = 0;
     long long sumObj = 0;
     double sumTime = 0;
+    lsCountersReset();
     
     for (int run = 0; run < runs; run++) {
         auto res = algorithmFunc();
@@ -67,6 +77,7 @@ AlgorithmResult evaluateIterativeAlgorithm(
     
     result.avgObj = sumObj / runs;
     result.avgTime = sumTime / runs;
+    result.counters = lsCountersSnapshot();
     return result;
 }
 
@@ -2,7 +2,8 @@
 #define CALCULATE_OBJECTIVE_H
 
 #include <vector>
+#include "distanceMatrix.h"
 
-int calculateObjective(const std::vector<int>& solution, const std::vector<std::vector<int>>& distance, const std::vector<int>& costs);
+int calculateObjective(const std::vector<int>& solution, const DistanceMatrix& distance, const std::vector<int>& costs);
 
 #endif
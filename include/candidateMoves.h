@@ -2,11 +2,13 @@
 #define CANDIDATE_MOVES_H
 
 #include <vector>
+#include "distanceMatrix.h"
+#include "localSearchWorkspace.h"
 
 // Build nearest neighbors for each node based on distance + cost
 std::vector<std::vector<int>> buildNearestNeighbors(
     int n,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     int k
 );
@@ -14,10 +16,21 @@ std::vector<std::vector<int>> buildNearestNeighbors(
 // Steepest local search with candidate moves (edges exchange)
 std::vector<int> localSearchSteepestEdgesCandidates(
     const std::vector<int>& initialSolution,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     int n,
     int k
 );
 
+// Same with neighbour lists built once by the caller (buildNearestNeighbors),
+// in the workspace's buffers
+const std::vector<int>& localSearchSteepestEdgesCandidates(
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    const std::vector<std::vector<int>>& neighbors,
+    LSWorkspace& workspace
+);
+
 #endif
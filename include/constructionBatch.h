@@ -0,0 +1,56 @@
+#ifndef CONSTRUCTION_BATCH_H
+#define CONSTRUCTION_BATCH_H
+
+#include <vector>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include "distanceMatrix.h"
+#include "neighborRanking.h"
+
+// Solutions built for a list of start nodes and the wall time (ms) of each construction
+struct BatchSolutions {
+    std::vector<std::vector<int>> solutions;
+    std::vector<double> timesMs;
+};
+
+// Threads a batch may use on this matrix: lazy matrices mutate their row cache on lookup
+int batchThreads(const DistanceMatrix& distance, int requested);
+
+// Build every start with build(start, workspace). Each thread creates one
+// workspace with makeWorkspace() and reuses it for all of its starts, which
+// are handed out one at a time. threads <= 1 runs on the calling thread.
+template <class Workspace>
+BatchSolutions buildBatch(const std::vector<int>& starts, int threads,
+                          const std::function<Workspace()>& makeWorkspace,
+                          const std::function<std::vector<int>(int, Workspace&)>& build) {
+    BatchSolutions batch;
+    batch.solutions.resize(starts.size());
+    batch.timesMs.resize(starts.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        Workspace workspace = makeWorkspace();
+        for (size_t index = next++; index < starts.size(); index = next++) {
+            auto begin = std::chrono::high_resolution_clock::now();
+            batch.solutions[index] = build(starts[index], workspace);
+            auto end = std::chrono::high_resolution_clock::now();
+            batch.timesMs[index] = std::chrono::duration<double, std::milli>(end - begin).count();
+        }
+    };
+    threads = std::min<int>(threads, starts.size());
+    if (threads <= 1) {
+        worker();
+        return batch;
+    }
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) pool.emplace_back(worker);
+    for (std::thread& thread : pool) thread.join();
+    return batch;
+}
+
+// Start nodes 0..n-1
+std::vector<int> allStarts(int n);
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef DISTANCE_MATRIX_H
+#define DISTANCE_MATRIX_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+// Element width used to store distances (chosen when the matrix is built)
+enum class DistanceWidth {
+    Int16,
+    Int32
+};
+
+// How distances are provided
+enum class DistanceStorage {
+    Full,     // precomputed n x n matrix
+    Packed,   // precomputed upper triangle (with diagonal), n * (n + 1) / 2 entries
+    Lazy      // computed from coordinates on demand, hot rows kept in a bounded cache
+};
+
+// State of a lazy matrix: coordinates and an LRU cache of whole rows.
+// Rows are admitted once their scalar misses reach n / LAZY_ADMIT_RATIO, so
+// computing a row never costs more than a constant factor of the lookups
+// already spent on it. Lookups mutate the cache: not thread-safe.
+struct LazyDistances {
+    static constexpr int LAZY_ADMIT_RATIO = 16;
+
+    int n = 0;
+    std::vector<int> xs, ys;
+    int capacity = 0;
+    int admitThreshold = 1;
+    std::vector<int> slotOf;              // row -> cache slot, -1 if not cached
+    std::vector<int> rowOfSlot;           // cache slot -> row, -1 if free
+    std::vector<unsigned long long> lastUse;
+    unsigned long long tick = 0;
+    std::vector<int32_t> rows;            // capacity * n distances
+    std::vector<int> misses;              // scalar misses per row since it was last cached
+
+    int lookup(int i, int j) {
+        int slot = slotOf[i];
+        if (slot < 0) {
+            std::swap(i, j);
+            slot = slotOf[i];
+            if (slot < 0) return miss(j, i);
+        }
+        lastUse[slot] = ++tick;
+        return rows[(size_t)slot * n + j];
+    }
+
+    int miss(int i, int j);
+    const int32_t* loadRow(int i);
+};
+
+// Compute round(sqrt(dx^2 + dy^2)) from node i to every node, vectorised when AVX2 is available
+void computeDistanceRow(int i, const int* xs, const int* ys, int n, int32_t* out);
+
+// Row-major n x n distance matrix stored in a single contiguous block.
+// distance[i][j] and distance(i, j) both return the distance as int.
+// Copies are cheap and share the same (immutable once built) storage.
+// Packed and lazy matrices offer the same interface with less memory.
+class DistanceMatrix {
+public:
+    // Lightweight view of one row so that existing distance[i][j] code keeps working
+    class Row {
+    public:
+        Row(const int16_t* row) : data(row), kind(Kind::Full16) {}
+        Row(const int32_t* row) : data(row), kind(Kind::Full32) {}
+        Row(const void* packed, DistanceWidth width, int i)
+            : data(packed), kind(width == DistanceWidth::Int16 ? Kind::Packed16 : Kind::Packed32), i(i) {}
+        Row(LazyDistances* lazy, int i) : lazy(lazy), kind(Kind::Lazy), i(i) {}
+        int operator[](int j) const {
+            switch (kind) {
+            case Kind::Full16: return static_cast<const int16_t*>(data)[j];
+            case Kind::Full32: return static_cast<const int32_t*>(data)[j];
+            case Kind::Packed16: return static_cast<const int16_t*>(data)[packedIndex(i, j)];
+            case Kind::Packed32: return static_cast<const int32_t*>(data)[packedIndex(i, j)];
+            default: return lazy->lookup(i, j);
+            }
+        }
+
+    private:
+        enum class Kind { Full16, Full32, Packed16, Packed32, Lazy };
+        const void* data = nullptr;
+        LazyDistances* lazy = nullptr;
+        Kind kind;
+        int i = 0;
+    };
+
+    // Column-major upper triangle: column hi holds rows 0..hi. min/max compile to
+    // conditional moves, so the index is branch-free and does not depend on n.
+    static size_t packedIndex(int i, int j) {
+        size_t lo = i < j ? i : j;
+        size_t hi = i < j ? j : i;
+        return hi * (hi + 1) / 2 + lo;
+    }
+
+    DistanceMatrix() = default;
+    DistanceMatrix(int n, DistanceWidth width, DistanceStorage storage = DistanceStorage::Full);
+
+    // Smallest width that holds every distance between the given coordinates
+    static DistanceWidth widthFor(const std::vector<int>& xs, const std::vector<int>& ys);
+
+    // Euclidean distances rounded to integers; width is picked from the largest distance
+    static DistanceMatrix fromCoordinates(const std::vector<int>& xs, const std::vector<int>& ys);
+    static DistanceMatrix fromCoordinates(const std::vector<int>& xs, const std::vector<int>& ys, DistanceWidth width);
+
+    // Same distances in packed symmetric storage (about half the memory of a full matrix)
+    static DistanceMatrix packed(const std::vector<int>& xs, const std::vector<int>& ys);
+    static DistanceMatrix packed(const std::vector<int>& xs, const std::vector<int>& ys, DistanceWidth width);
+
+    // Matrix over externally owned elements (e.g. a memory-mapped cache file kept alive by owner)
+    static DistanceMatrix view(int n, DistanceWidth width, DistanceStorage storage,
+                               const void* elements, std::shared_ptr<const void> owner);
+
+    // Coordinate-only matrix caching at most cacheRows rows (0 disables the cache)
+    static DistanceMatrix lazy(const std::vector<int>& xs, const std::vector<int>& ys, int cacheRows);
+
+    int size() const { return n; }
+    DistanceWidth width() const { return elementWidth; }
+    DistanceStorage storage() const { return storageKind; }
+
+    int operator()(int i, int j) const { return (*this)[i][j]; }
+    Row operator[](int i) const {
+        if (storageKind == DistanceStorage::Full) {
+            return elementWidth == DistanceWidth::Int32 ? Row(row32(i)) : Row(row16(i));
+        }
+        if (storageKind == DistanceStorage::Packed) return Row(elements, elementWidth, i);
+        return Row(lazyState.get(), i);
+    }
+
+    void set(int i, int j, int value);
+
+    // Coordinates the distances were computed from (absent for matrices filled with set())
+    bool hasCoordinates() const { return coordinates != nullptr; }
+    const std::vector<int>& xs() const { return coordinates->xs; }
+    const std::vector<int>& ys() const { return coordinates->ys; }
+    void attachCoordinates(const std::vector<int>& xs, const std::vector<int>& ys);
+
+    // Raw row pointers for kernels specialised on the element width (full storage only)
+    const int16_t* row16(int i) const { return static_cast<const int16_t*>(elements) + (size_t)i * n; }
+    const int32_t* row32(int i) const { return static_cast<const int32_t*>(elements) + (size_t)i * n; }
+
+    const void* data() const { return elements; }
+    size_t elementSize() const { return elementWidth == DistanceWidth::Int16 ? 2 : 4; }
+    size_t elementCount() const {
+        return storageKind == DistanceStorage::Packed ? (size_t)n * (n + 1) / 2 : (size_t)n * n;
+    }
+    size_t bytes() const { return elementCount() * elementSize(); }
+
+private:
+    int n = 0;
+    DistanceWidth elementWidth = DistanceWidth::Int32;
+    DistanceStorage storageKind = DistanceStorage::Full;
+    const void* elements = nullptr;
+    std::shared_ptr<const void> owner;
+    std::shared_ptr<LazyDistances> lazyState;
+
+    struct Coordinates {
+        std::vector<int> xs, ys;
+    };
+    std::shared_ptr<const Coordinates> coordinates;
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef EDGE_GRID_H
+#define EDGE_GRID_H
+
+#include <vector>
+#include <algorithm>
+
+// Uniform grid over the bounding box of all nodes holding tour edges, each
+// filed under the cell of its midpoint. For a node i and an edge (a, b) with
+// rounded Euclidean distances,
+//     d(a, i) + d(i, b) - d(a, b) >= 2 |i - midpoint(a, b)| - d(a, b) - 2,
+// so once every cell within ring r of i's cell has been visited, no other
+// edge can give i an insertion delta below 2 r cellSize() - maxLength() - 2.
+// Edges are identified by an id in [0, n) (e.g. their first node). Cells are
+// linked lists through per-edge arrays, so filing edges never allocates.
+class EdgeGrid {
+public:
+    EdgeGrid(const std::vector<int>& xs, const std::vector<int>& ys, int cellCount);
+
+    void clear();
+    // File edge (a, b) of the given length under its midpoint, replacing its previous place
+    void place(int edge, int a, int b, int length);
+    void remove(int edge);
+
+    int length(int edge) const { return edgeLength[edge]; }
+    int maxLength() const { return longest; }
+    double cellSize() const { return side; }
+
+    // Call visit(edge) for every edge in the cells at Chebyshev distance ring
+    // from node's cell and add the number of cells in the ring to cellsVisited.
+    // Returns false (visiting nothing) once the ring lies entirely outside the grid.
+    template <class Visit>
+    bool visitRing(int node, int ring, Visit visit, int& cellsVisited) const {
+        int cx = cellX(xs[node]), cy = cellY(ys[node]);
+        int x0 = cx - ring, x1 = cx + ring, y0 = cy - ring, y1 = cy + ring;
+        if (x0 < 0 && y0 < 0 && x1 >= width && y1 >= height) return false;
+        auto visitCell = [&](int x, int y) {
+            cellsVisited++;
+            for (int edge = cellHead[y * width + x]; edge != NONE; edge = nextInCell[edge]) visit(edge);
+        };
+        for (int x = std::max(x0, 0); x <= std::min(x1, width - 1); x++) {
+            if (y0 >= 0) visitCell(x, y0);
+            if (y1 < height && ring > 0) visitCell(x, y1);
+        }
+        for (int y = std::max(y0 + 1, 0); y <= std::min(y1 - 1, height - 1); y++) {
+            if (x0 >= 0) visitCell(x0, y);
+            if (x1 < width) visitCell(x1, y);
+        }
+        return true;
+    }
+
+private:
+    static constexpr int NONE = -1;
+
+    int cellX(double x) const { return std::min(width - 1, std::max(0, (int)((x - minX) / side))); }
+    int cellY(double y) const { return std::min(height - 1, std::max(0, (int)((y - minY) / side))); }
+
+    const std::vector<int>& xs;
+    const std::vector<int>& ys;
+    double minX = 0, minY = 0, side = 1;
+    int width = 1, height = 1;
+    std::vector<int> cellHead;      // first edge of each cell, NONE if empty
+    std::vector<int> cellOf;        // NONE if the edge is not in the grid
+    std::vector<int> nextInCell;    // neighbours in the cell's list, NONE at the ends
+    std::vector<int> prevInCell;
+    std::vector<int> edgeLength;
+    std::vector<int> lengthCount;   // number of filed edges per length
+    int longest = 0;
+};
+
+#endif
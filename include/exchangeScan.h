@@ -0,0 +1,48 @@
+#ifndef EXCHANGE_SCAN_H
+#define EXCHANGE_SCAN_H
+
+#include <vector>
+#include "distanceMatrix.h"
+
+// Unselected nodes in ascending order with their costs side by side: the
+// candidates of the inter-route exchange scans, read eight at a time
+class ExchangeCandidates {
+public:
+    ExchangeCandidates() = default;
+    ExchangeCandidates(const std::vector<bool>& inSolution, const std::vector<int>& costs);
+
+    // Start over from another solution, keeping the storage
+    void reset(const std::vector<bool>& inSolution, const std::vector<int>& costs);
+
+    // newNode enters the tour in place of oldNode
+    void exchange(int oldNode, int newNode);
+
+    int size() const { return nodeList.size(); }
+    const int* nodes() const { return nodeList.data(); }
+    const int* nodeCosts() const { return costList.data(); }
+
+private:
+    const std::vector<int>* costTable = nullptr;
+    std::vector<int> nodeList;
+    std::vector<int> costList;   // costs[nodeList[i]]
+};
+
+struct ExchangeDelta {
+    int node;
+    int delta;
+};
+
+// Exchange of the tour node between prev and next, removed = d(prev, node) +
+// d(node, next) + cost(node), against every candidate v:
+// delta = d(prev, v) + d(v, next) + cost(v) - removed.
+// Full matrices are scanned with AVX2 gathers when available.
+
+// Smallest delta, the smallest node among equal ones ({-1, INT_MAX} without candidates)
+ExchangeDelta bestExchange(const ExchangeCandidates& candidates, int prev, int next, int removed,
+                           const DistanceMatrix& distance);
+
+// Append every candidate with delta < 0 to moves, in ascending node order
+void improvingExchanges(const ExchangeCandidates& candidates, int prev, int next, int removed,
+                        const DistanceMatrix& distance, std::vector<ExchangeDelta>& moves);
+
+#endif
@@ -4,6 +4,7 @@
 #include <vector>
 #include <string>
 #include <random>
+#include "distanceMatrix.h"
 
 struct ConvexityData {
     std::vector<double> objectives;
@@ -37,7 +38,7 @@ GlobalConvexityResult analyzeGlobalConvexity(
     const std::string& instanceName,
     int n,
     int selectCount,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     const std::vector<int>& bestSolutionFromBestMethod,
     std::mt19937& rng
@@ -2,7 +2,15 @@
 #define GREEDY_CYCLE_H
 
 #include <vector>
+#include "distanceMatrix.h"
+#include "constructionBatch.h"
 
-std::vector<int> greedyCycle(int startNode, int selectCount, const std::vector<std::vector<int>>& distance, const std::vector<int>& costs);
+// ranking (optional) gives the second node without a scan
+std::vector<int> greedyCycle(int startNode, int selectCount, const DistanceMatrix& distance, const std::vector<int>& costs,
+                             const NeighborRanking* ranking = nullptr);
+
+// greedyCycle for every start, each thread reusing one InsertionCache (same solutions)
+BatchSolutions greedyCycleBatch(const std::vector<int>& starts, int selectCount, const DistanceMatrix& distance,
+                                const std::vector<int>& costs, int threads = 1);
 
 #endif
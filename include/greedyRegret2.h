@@ -2,7 +2,11 @@
 #define GREEDY_REGRET2_H
 
 #include <vector>
+#include "distanceMatrix.h"
+#include "neighborRanking.h"
 
-std::vector<int> greedyRegret2(int startNode, int selectCount, const std::vector<std::vector<int>>& distance, const std::vector<int>& costs);
+// ranking (optional) gives the second node without a scan
+std::vector<int> greedyRegret2(int startNode, int selectCount, const DistanceMatrix& distance, const std::vector<int>& costs,
+                               const NeighborRanking* ranking = nullptr);
 
 #endif
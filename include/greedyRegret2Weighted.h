@@ -2,7 +2,11 @@
 #define GREEDY_REGRET2_WEIGHTED_H
 
 #include <vector>
+#include "distanceMatrix.h"
+#include "neighborRanking.h"
 
-std::vector<int> greedyRegret2Weighted(int startNode, int selectCount, const std::vector<std::vector<int>>& distance, const std::vector<int>& costs, double wRegret = 1.0, double wBest = 1.0);
+// ranking (optional) gives the second node without a scan
+std::vector<int> greedyRegret2Weighted(int startNode, int selectCount, const DistanceMatrix& distance, const std::vector<int>& costs, double wRegret = 1.0, double wBest = 1.0,
+                                       const NeighborRanking* ranking = nullptr);
 
 #endif
@@ -0,0 +1,12 @@
+#ifndef GREEDY_REGRET_K_H
+#define GREEDY_REGRET_K_H
+
+#include <vector>
+#include "distanceMatrix.h"
+
+// Weighted k-regret greedy cycle: regret = sum over the k cheapest insertions of
+// (delta_j - delta_1), score = wRegret * regret - wBest * delta_1.
+// k = 2 gives the same tours as greedyRegret2Weighted; k < 1 is taken as 1.
+std::vector<int> greedyRegretK(int startNode, int selectCount, const DistanceMatrix& distance, const std::vector<int>& costs, int k = 3, double wRegret = 1.0, double wBest = 1.0);
+
+#endif
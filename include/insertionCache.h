@@ -0,0 +1,80 @@
+#ifndef INSERTION_CACHE_H
+#define INSERTION_CACHE_H
+
+#include <vector>
+#include "distanceMatrix.h"
+#include "linkedTour.h"
+#include "edgeGrid.h"
+
+// What the insertion positions connect
+enum class TourShape {
+    Cycle,   // m edges, the last one closing the cycle; insert after any tour node
+    Path     // open path: front, m - 1 edges and back; insert after FRONT or any tour node
+};
+
+// Growing tour together with the best and second-best insertion of every
+// unselected node. Inserting node x into edge (a, b) only destroys (a, b) and
+// creates (a, x) and (x, b), so a node's cache is updated with the two new
+// edges and rescanned only if one of its two best edges was (a, b).
+// Ties are broken by the insertion position, exactly like a full scan over
+// all positions in order with strict comparisons. The tour is a LinkedTour,
+// so an insertion costs O(1) plus the O(n) pass over the unselected nodes.
+// When the matrix knows its coordinates, rescans walk an EdgeGrid outwards
+// from the node and stop as soon as no farther edge can beat its second-best
+// insertion; they fall back to a full scan when the grid search gets more
+// expensive than one (small or sparse tours), so results stay exact.
+class InsertionCache {
+public:
+    InsertionCache(const DistanceMatrix& distance, const std::vector<int>& costs, TourShape shape = TourShape::Cycle);
+
+    // Start from the given tour (at least one node)
+    void reset(const std::vector<int>& nodes);
+
+    // Insert node right after the given tour node (LinkedTour::FRONT: before the first one)
+    void insertAfter(int node, int after);
+
+    std::vector<int> toVector() const { return tour.toVector(); }
+    void toVector(std::vector<int>& nodes) const { tour.toVector(nodes); }
+    int size() const { return tour.size(); }
+    bool selected(int node) const { return tour.contains(node); }
+
+    // Cheapest insertion delta (including the node cost) of an unselected node,
+    // the second cheapest (INT_MAX if there is a single position) and the
+    // node to pass to insertAfter() for the cheapest one
+    int best1(int node) const { return entries[node].best1; }
+    int best2(int node) const { return entries[node].best2; }
+    int bestAfter(int node) const { return entries[node].edge1; }
+
+    // Unselected nodes whose best1 or best2 changed in the last insertAfter()
+    const std::vector<int>& changed() const { return changedNodes; }
+
+private:
+    // Edges are identified by their first node: edge u is (u, successor of u).
+    // In a path the last node's edge is the back end and FRONT the front end.
+    static constexpr int FRONT = LinkedTour::FRONT;
+    static constexpr int NONE = LinkedTour::NONE;
+    // Below this tour size a rescan simply walks the whole tour
+    static constexpr int GRID_MIN_TOUR = 64;
+
+    struct Entry {
+        int best1, best2;
+        int edge1, edge2;
+    };
+
+    void rescan(int node);
+    void scanTour(int node);
+    void offer(Entry& entry, int value, int edge) const;
+    // Refile edge "from" in the grid after its end changed
+    void placeEdge(int from, int length);
+
+    const DistanceMatrix& distance;
+    const std::vector<int>& costs;
+    TourShape shape;
+    LinkedTour tour;
+    std::vector<Entry> entries;
+    std::vector<int> changedNodes;
+    bool spatial;
+    EdgeGrid grid;
+};
+
+#endif
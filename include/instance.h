@@ -0,0 +1,72 @@
+#ifndef INSTANCE_H
+#define INSTANCE_H
+
+#include <vector>
+#include <string>
+#include "distanceMatrix.h"
+
+// Problem instance: node coordinates, node costs and the distance matrix
+struct Instance {
+    std::string filename;
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<int> costs;
+    DistanceMatrix distance;
+    // CSV row of every node when the nodes were renumbered; empty if they keep the CSV order
+    std::vector<int> originalIds;
+
+    int size() const { return costs.size(); }
+    int originalId(int node) const { return originalIds.empty() ? node : originalIds[node]; }
+    // Solution in CSV row numbers, for printing and exporting
+    std::vector<int> toOriginalIds(const std::vector<int>& solution) const;
+};
+
+// How loadInstance provides distances
+enum class DistanceMode {
+    Auto,     // full matrix if it fits in fullMatrixLimit bytes, else packed, else lazy
+    Full,     // precomputed matrix, loaded through the binary cache
+    Packed,   // precomputed upper triangle, loaded through the binary cache
+    Lazy      // computed from coordinates on demand (no cache file)
+};
+
+struct InstanceOptions {
+    DistanceMode distanceMode = DistanceMode::Auto;
+    int lazyCacheRows = 1024;                   // rows kept by the lazy LRU cache
+    size_t fullMatrixLimit = (size_t)2 << 30;   // 2 GB, for full or packed storage
+    bool hilbertOrder = false;                  // renumber nodes along a Hilbert curve after loading
+};
+
+// Read "x;y;cost" rows from a CSV file and optionally compute the distance matrix.
+// The file is parsed in place (memory-mapped) with std::from_chars; a malformed
+// row is reported with its line number on stderr and yields an empty instance.
+Instance readInstanceCsv(const std::string& filename, bool computeDistances = true);
+
+// Load an instance through its binary cache (<name>.bin next to the CSV).
+// The cache is memory-mapped when it is up to date, otherwise the CSV is
+// parsed and a fresh cache is written for the next run. In lazy mode only
+// the coordinates are read and distances are computed on demand. The cache
+// always holds the CSV order; hilbertOrder renumbers the loaded instance.
+Instance loadInstance(const std::string& filename, const InstanceOptions& options = InstanceOptions());
+
+// Node order along a Hilbert curve over the bounding box of the coordinates,
+// so that spatially close nodes get close ids (ties keep the CSV order)
+std::vector<int> hilbertOrder(const std::vector<int>& xs, const std::vector<int>& ys);
+
+// Renumber nodes so that new node i is old node order[i]. Distances are rebuilt
+// from the coordinates in the same storage and width; originalIds keeps the CSV rows.
+void renumberNodes(Instance& instance, const std::vector<int>& order, int lazyCacheRows);
+
+// Binary cache format (native endianness):
+//   header  - magic, version, n, distance element size, packed flag, source CSV
+//             size and modification time, checksums of the node data and matrix
+//   nodes   - int32 xs[n], ys[n], costs[n]
+//   matrix  - n * n distances, row-major, or n * (n + 1) / 2 when packed
+//             (see DistanceMatrix::packedIndex); 2 or 4 bytes each
+std::string instanceCacheFilename(const std::string& csvFilename);
+bool writeInstanceCache(const Instance& instance, const std::string& cacheFilename);
+// Node data is always verified; the O(n^2) matrix checksum only on request
+// (otherwise n sampled entries are recomputed from the coordinates)
+bool readInstanceCache(const std::string& cacheFilename, const std::string& csvFilename,
+                       Instance& instance, bool verifyMatrix = false);
+
+#endif
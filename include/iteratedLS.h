@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <random>
+#include "distanceMatrix.h"
+#include "localSearch.h"
 
 struct ILSResult {
     std::vector<int> bestSolution;
@@ -11,15 +13,40 @@ struct ILSResult {
     int lsRuns;
 };
 
+// Buffers of one ILS run: the local search workspace and the perturbation's
+// scratch, sized once and reused by every iteration
+struct ILSWorkspace {
+    explicit ILSWorkspace(int n);
+
+    LSWorkspace search;
+    std::vector<int> perturbed;
+    std::vector<bool> inSolution;
+    std::vector<int> notSelected;
+};
+
+// One ILS iteration: perturb current and run the local search on it. Returns
+// the local optimum, a reference into workspace valid until the next iteration.
+const std::vector<int>& iteratedLSStep(
+    const std::vector<int>& current,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    const std::vector<std::vector<int>>& neighbors,
+    LocalSearchKind localSearch,
+    std::mt19937& rng,
+    ILSWorkspace& workspace
+);
+
 // Iterated Local Search - applies perturbation and local search iteratively
 ILSResult iteratedLS(
     int n,
     int selectCount,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     const std::vector<std::vector<int>>& randomInitials,
     double timeLimit,
-    std::mt19937& rng
+    std::mt19937& rng,
+    LocalSearchKind localSearch = LocalSearchKind::SteepestEdges
 );
 
 #endif
@@ -3,6 +3,9 @@
 
 #include <vector>
 #include <random>
+#include "distanceMatrix.h"
+#include "localSearch.h"
+#include "insertionCache.h"
 
 struct LNSResult {
     std::vector<int> bestSolution;
@@ -11,28 +14,61 @@ struct LNSResult {
     int iterations;  // Number of destroy-repair iterations
 };
 
+// Buffers of one LNS run: the destroy scratch, the repair's insertion cache
+// and the local search workspace, sized once and reused by every iteration
+struct LNSWorkspace {
+    LNSWorkspace(const DistanceMatrix& distance, const std::vector<int>& costs, int n);
+
+    LSWorkspace search;
+    InsertionCache repair;
+    std::vector<double> weights;     // removal weight per position
+    std::vector<bool> removed;       // per position
+    std::vector<bool> inSolution;    // per node, for the repair's start of a near-empty tour
+    std::vector<int> partial;        // destroyed solution
+    std::vector<int> repaired;
+};
+
+// One LNS iteration: destroy and repair current, then run the local search on
+// the repaired solution if withLocalSearch. Returns the new solution, a
+// reference into workspace valid until the next iteration.
+const std::vector<int>& largeNeighborhoodSearchStep(
+    const std::vector<int>& current,
+    int n,
+    int selectCount,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    double destroyFraction,
+    bool withLocalSearch,
+    LocalSearchKind localSearch,
+    const std::vector<std::vector<int>>& neighbors,
+    std::mt19937& rng,
+    LNSWorkspace& workspace
+);
+
 // Large Neighborhood Search - with local search after destroy-repair
 LNSResult largeNeighborhoodSearchWithLS(
     int n,
     int selectCount,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     const std::vector<std::vector<int>>& randomInitials,
     double timeLimit,
     std::mt19937& rng,
-    double destroyFraction = 0.30  // Default: remove 30% of nodes
+    double destroyFraction = 0.30,  // Default: remove 30% of nodes
+    LocalSearchKind localSearch = LocalSearchKind::SteepestEdges
 );
 
 // Large Neighborhood Search - without local search after destroy-repair
 LNSResult largeNeighborhoodSearchNoLS(
     int n,
     int selectCount,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     const std::vector<std::vector<int>>& randomInitials,
     double timeLimit,
     std::mt19937& rng,
-    double destroyFraction = 0.30  // Default: remove 30% of nodes
+    double destroyFraction = 0.30,  // Default: remove 30% of nodes
+    LocalSearchKind localSearch = LocalSearchKind::SteepestEdges
 );
 
 #endif
@@ -0,0 +1,52 @@
+#ifndef LINKED_TOUR_H
+#define LINKED_TOUR_H
+
+#include <vector>
+
+// Tour under construction stored as successor/predecessor arrays over all n
+// nodes, so inserting a node is O(1). Every node in the tour also carries an
+// order label increasing from first() to last(), which lets callers compare
+// positions without indices; labels are respaced (O(size)) only when two
+// neighbours run out of room between them.
+class LinkedTour {
+public:
+    static constexpr int FRONT = -2;   // "after" value that inserts before first()
+    static constexpr int NONE = -1;
+
+    explicit LinkedTour(int n);
+
+    // Replace the tour with the given nodes in order
+    void reset(const std::vector<int>& nodes);
+    // Insert node right after the given tour node (or FRONT)
+    void insertAfter(int node, int after);
+
+    int size() const { return count; }
+    bool contains(int node) const { return next[node] != NONE; }
+    int first() const { return head; }
+    int last() const { return tail; }
+    // Neighbours along the path; the successor of last() is first() (cycle view)
+    int successor(int node) const { return node == tail ? head : next[node]; }
+    int predecessor(int node) const { return node == head ? tail : prev[node]; }
+    // Path view: NONE past either end
+    int after(int node) const { return node == tail ? NONE : next[node]; }
+
+    // True if a comes before b along the tour (FRONT comes before every node)
+    bool before(int a, int b) const { return labelOf(a) < labelOf(b); }
+
+    std::vector<int> toVector() const;
+    // Same into nodes, reusing its storage
+    void toVector(std::vector<int>& nodes) const;
+
+private:
+    static constexpr long long GAP = 1LL << 20;
+
+    long long labelOf(int node) const { return node == FRONT ? -(1LL << 62) : label[node]; }
+    void relabel();
+
+    int count = 0;
+    int head = NONE, tail = NONE;
+    std::vector<int> next, prev;       // NONE if the node is not in the tour
+    std::vector<long long> label;
+};
+
+#endif
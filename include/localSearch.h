@@ -3,56 +3,174 @@
 
 #include <vector>
 #include <random>
+#include "distanceMatrix.h"
+#include "localSearchWorkspace.h"
+
+// Every search has an overload taking an LSWorkspace: it runs in the
+// workspace's buffers and returns a reference to workspace.solution, valid
+// until the next search in that workspace. Metaheuristics calling a search
+// in a loop keep one workspace for the run. The candidate searches' overloads
+// take neighbour lists built once by the caller instead of k.
 
 // Local search with steepest descent and nodes exchange (intra-route)
 std::vector<int> localSearchSteepestNodes(
     const std::vector<int>& initialSolution,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     int n
 );
 
+const std::vector<int>& localSearchSteepestNodes(
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    LSWorkspace& workspace
+);
+
 // Local search with steepest descent and edges exchange (intra-route)
 std::vector<int> localSearchSteepestEdges(
     const std::vector<int>& initialSolution,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     int n
 );
 
+const std::vector<int>& localSearchSteepestEdges(
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    LSWorkspace& workspace
+);
+
+// Steepest edges neighbourhood restricted by neighbour lists and don't-look bits:
+// each node in the queue tries the 2-opt and exchange moves that create an
+// edge to one of its neighbours, applies the best improving one and wakes the
+// endpoints of the changed edges; a node without an improving move sleeps
+// until one of its edges changes. Stops when no node is awake.
+std::vector<int> localSearchDontLookBits(
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    const std::vector<std::vector<int>>& neighbors
+);
+
+const std::vector<int>& localSearchDontLookBits(
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    const std::vector<std::vector<int>>& neighbors,
+    LSWorkspace& workspace
+);
+
+// Same with the k nearest neighbours (distance + cost) of every node built per call
+std::vector<int> localSearchDontLookBits(
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    int k
+);
+
+// Local search run after each perturbation by ILS and LNS
+enum class LocalSearchKind {
+    SteepestEdges,   // localSearchSteepestEdges: whole neighbourhood every iteration
+    DontLookBits     // localSearchDontLookBits with DONT_LOOK_NEIGHBORS neighbours per node
+};
+
+constexpr int DONT_LOOK_NEIGHBORS = 10;
+
+// Run the chosen local search; neighbors is only read by DontLookBits
+std::vector<int> runLocalSearch(
+    LocalSearchKind kind,
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    const std::vector<std::vector<int>>& neighbors
+);
+
+const std::vector<int>& runLocalSearch(
+    LocalSearchKind kind,
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    const std::vector<std::vector<int>>& neighbors,
+    LSWorkspace& workspace
+);
+
 // Local search with greedy (random order) and nodes exchange (intra-route)
 std::vector<int> localSearchGreedyNodes(
     const std::vector<int>& initialSolution,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     int n,
     std::mt19937& rng
 );
 
+const std::vector<int>& localSearchGreedyNodes(
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    std::mt19937& rng,
+    LSWorkspace& workspace
+);
+
 // Local search with greedy (random order) and edges exchange (intra-route)
 std::vector<int> localSearchGreedyEdges(
     const std::vector<int>& initialSolution,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     int n,
     std::mt19937& rng
 );
 
+const std::vector<int>& localSearchGreedyEdges(
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    std::mt19937& rng,
+    LSWorkspace& workspace
+);
+
 // Local search with steepest descent using list of improving moves (edges exchange)
 std::vector<int> localSearchSteepestEdgesLM(
     const std::vector<int>& initialSolution,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     int n
 );
 
+const std::vector<int>& localSearchSteepestEdgesLM(
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    LSWorkspace& workspace
+);
+
 // Local search with steepest descent using list of improving moves and candidate moves (edges exchange)
 std::vector<int> localSearchSteepestEdgesLMCandidates(
     const std::vector<int>& initialSolution,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     int n,
     int k
 );
 
+const std::vector<int>& localSearchSteepestEdgesLMCandidates(
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    const std::vector<std::vector<int>>& neighbors,
+    LSWorkspace& workspace
+);
+
 #endif
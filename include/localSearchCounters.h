@@ -0,0 +1,65 @@
+#ifndef LOCAL_SEARCH_COUNTERS_H
+#define LOCAL_SEARCH_COUNTERS_H
+
+#include <atomic>
+
+// Move-level counters of the local searches, to tell whether a slower run
+// iterates more, evaluates more moves or applies more expensive ones. They are
+// compiled in only with -DLS_COUNTERS (CXXFLAGS=-DLS_COUNTERS ./run.sh);
+// otherwise LS_COUNT and LS_COUNT_MAX expand to nothing and do not evaluate
+// their arguments.
+struct LSCounters {
+    long long deltaEvaluations = 0;   // move deltas computed
+    long long improvingMoves = 0;     // improving moves found (list of moves: added to the list)
+    long long intraApplied = 0;       // node swaps and 2-opt moves applied
+    long long exchangeApplied = 0;    // exchanges with an unselected node applied
+    long long candidateChecks = 0;    // neighbour list entries and candidate edge tests
+    long long staleDiscarded = 0;     // list moves dropped because their edges or node are gone
+    long long listHighWater = 0;      // largest list of moves
+
+    bool empty() const { return deltaEvaluations == 0 && candidateChecks == 0; }
+};
+
+#ifdef LS_COUNTERS
+constexpr bool LS_COUNTERS_ENABLED = true;
+#else
+constexpr bool LS_COUNTERS_ENABLED = false;
+#endif
+
+// Totals of every search since the last lsCountersReset(), from all threads
+LSCounters lsCountersSnapshot();
+void lsCountersReset();
+
+namespace lsCountersDetail {
+
+struct Totals {
+    std::atomic<long long> deltaEvaluations{0};
+    std::atomic<long long> improvingMoves{0};
+    std::atomic<long long> intraApplied{0};
+    std::atomic<long long> exchangeApplied{0};
+    std::atomic<long long> candidateChecks{0};
+    std::atomic<long long> staleDiscarded{0};
+    std::atomic<long long> listHighWater{0};
+};
+
+extern Totals totals;
+
+inline void raise(std::atomic<long long>& counter, long long value) {
+    long long current = counter.load(std::memory_order_relaxed);
+    while (value > current && !counter.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+}
+
+// Searches add up their counts locally and pass them here once per row or
+// per call, so that the atomics stay out of the inner loops
+#ifdef LS_COUNTERS
+#define LS_COUNT(counter, amount) \
+    lsCountersDetail::totals.counter.fetch_add((amount), std::memory_order_relaxed)
+#define LS_COUNT_MAX(counter, value) lsCountersDetail::raise(lsCountersDetail::totals.counter, (value))
+#else
+#define LS_COUNT(counter, amount) ((void)sizeof(amount))
+#define LS_COUNT_MAX(counter, value) ((void)sizeof(value))
+#endif
+
+#endif
@@ -0,0 +1,802 @@
+#ifndef LOCAL_SEARCH_ENGINE_H
+#define LOCAL_SEARCH_ENGINE_H
+
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <climits>
+#include <iterator>
+#include <type_traits>
+#include "distanceMatrix.h"
+#include "moveDeltas.h"
+#include "localSearchWorkspace.h"
+#include "localSearchCounters.h"
+
+// Local search engine behind the steepest, greedy, candidate and list-of-moves
+// searches. localSearchEngine<Selection, Intra, Restriction> picks its loop at
+// compile time and the policies' members are inlined into it:
+//
+//   Selection    Steepest | Greedy | MoveList      how the applied move is chosen
+//   Intra        SwapNodes | ReverseSegment        intra-route move on positions (i, j)
+//   Restriction  FullNeighborhood | CandidateNeighborhood   which moves are evaluated
+//
+// Inter-route moves always exchange a tour node with an unselected node.
+// Each implemented combination makes the same moves as the function it
+// replaced; the others are rejected by static_assert. The searches keep all
+// their state in an LSWorkspace and leave the result in its solution, and
+// report their moves through LS_COUNT (localSearchCounters.h).
+
+// --- Intra-route neighbourhoods ---
+
+// Swap the nodes at positions i and j
+struct SwapNodes {
+    static int delta(const std::vector<int>& sol, int i, int j, const DistanceMatrix& distance) {
+        return deltaSwapNodes(sol, i, j, distance);
+    }
+    static void apply(std::vector<int>& sol, int i, int j) { std::swap(sol[i], sol[j]); }
+};
+
+// Reverse sol[i + 1..j]: exchange the edges leaving positions i and j
+struct ReverseSegment {
+    static int delta(const std::vector<int>& sol, int i, int j, const DistanceMatrix& distance) {
+        return deltaReverseSegment(sol, i, j, distance);
+    }
+    static void apply(std::vector<int>& sol, int i, int j) { std::reverse(sol.begin() + i + 1, sol.begin() + j + 1); }
+};
+
+// --- Neighbourhood restrictions ---
+
+// Every move
+struct FullNeighborhood {
+    static constexpr bool restricted = false;
+    bool isCandidateEdge(int, int) const { return true; }
+};
+
+// Only moves adding a candidate edge: one endpoint is among the nearest
+// neighbours (buildNearestNeighbors) of the other
+struct CandidateNeighborhood {
+    static constexpr bool restricted = true;
+    const std::vector<std::vector<int>>& nearestNeighbors;
+
+    bool isCandidateEdge(int node1, int node2) const {
+        const auto& nn1 = nearestNeighbors[node1];
+        if (std::find(nn1.begin(), nn1.end(), node2) != nn1.end()) return true;
+        const auto& nn2 = nearestNeighbors[node2];
+        return std::find(nn2.begin(), nn2.end(), node1) != nn2.end();
+    }
+};
+
+// --- Selection policies ---
+
+// Best move of the neighbourhood every iteration
+struct Steepest {};
+
+// First improving move, the moves tried in a fresh random order after every improvement
+struct Greedy {
+    std::mt19937& rng;
+};
+
+// Steepest through a sorted list of improving moves, kept across iterations
+struct MoveList {};
+
+namespace localSearchDetail {
+
+// Cached steepest neighbourhood: intra row i holds the best pair (i, j > i),
+// inter row pos the best unselected node for position pos, each the first in
+// scan order among equal deltas. The rows are the leaves of a MinTree, intra
+// rows first, so its minimum is the move the full scan over (i, j) and then
+// (pos, node) picks. After a move only the entries it changed are evaluated
+// again. The rows live in the workspace, whose solution they read; the
+// unselected nodes are kept as ExchangeCandidates for the vectorised inter
+// row scans. Passes over all rows compute each row on its own and commit the
+// values to the tree afterwards, so with a WorkerPool they are split across
+// threads and still pick the same moves for any thread count.
+template <class Intra>
+class SteepestRows {
+public:
+    SteepestRows(LSWorkspace& workspace, const DistanceMatrix& distance, const std::vector<int>& costs, WorkerPool* pool)
+        : sol(workspace.solution), distance(distance), costs(costs), pool(pool), unselected(workspace.unselected),
+          m(sol.size()), tree(workspace.tree), rowValue(workspace.rowValue), intraColumn(workspace.intraColumn),
+          interNode(workspace.interNode), dirty(workspace.dirty) {
+        unselected.reset(workspace.inSolution, costs);
+        tree.reset(2 * m);
+        rowValue.assign(2 * m, INT_MAX);
+        intraColumn.assign(m, -1);
+        interNode.assign(m, -1);
+        dirty.assign(m, false);
+        auto rows = [&](int begin, int end) {
+            for (int i = begin; i < end; i++) rowValue[i] = intraRowBest(i);
+            for (int pos = begin; pos < end; pos++) rowValue[m + pos] = interRowBest(pos);
+        };
+        forRows((long long)m * (m + unselected.size()), rows);
+        commit(0, 2 * m);
+    }
+
+    int bestDelta() const { return tree.minValue(); }
+    bool bestIsIntra() const { return tree.minLeaf() < m; }
+    int bestRow() const { return tree.minLeaf() % m; }
+    // Second position of an intra move, new node of an inter move
+    int bestColumn() const { return bestIsIntra() ? intraColumn[bestRow()] : interNode[bestRow()]; }
+
+    int wrap(int pos) const { return (pos % m + m) % m; }
+
+    // Intra entries (i, j) with i or j in positions changed: recompute those rows
+    // and rows whose best column is among them, elsewhere only those columns
+    void refreshIntra(const std::vector<int>& positions) {
+        for (int p : positions) dirty[p] = true;
+        auto rows = [&](int begin, int end) {
+            long long evaluated = 0;
+            for (int i = begin; i < end; i++) {
+                if (dirty[i] || (intraColumn[i] >= 0 && dirty[intraColumn[i]])) {
+                    rowValue[i] = intraRowBest(i);
+                    continue;
+                }
+                int best = tree.value(i), column = intraColumn[i];
+                for (int j : positions) {
+                    if (j <= i) continue;
+                    int delta = Intra::delta(sol, i, j, distance);
+                    evaluated++;
+                    if (delta < best || (delta == best && j < column)) {
+                        best = delta;
+                        column = j;
+                    }
+                }
+                intraColumn[i] = column;
+                rowValue[i] = best;
+            }
+            LS_COUNT(deltaEvaluations, evaluated);
+        };
+        forRows((long long)m * positions.size(), rows);
+        commit(0, m);
+        for (int p : positions) dirty[p] = false;
+    }
+
+    void refreshInterRows(const std::vector<int>& positions) {
+        for (int pos : positions) interRow(pos);
+    }
+
+    // oldNode at position p was replaced by newNode: rows next to p are recomputed,
+    // the others lose newNode as a candidate and gain oldNode
+    void refreshInterExchange(int p, int oldNode, int newNode) {
+        unselected.exchange(oldNode, newNode);
+        auto rows = [&](int begin, int end) {
+            long long evaluated = 0;
+            for (int pos = begin; pos < end; pos++) {
+                int offset = wrap(pos - p);
+                if (offset <= 1 || offset == m - 1 || interNode[pos] == newNode) {
+                    rowValue[m + pos] = interRowBest(pos);
+                    continue;
+                }
+                int delta = deltaExchangeNodes(sol, pos, oldNode, distance, costs);
+                evaluated++;
+                int best = tree.value(m + pos);
+                if (delta < best || (delta == best && oldNode < interNode[pos])) {
+                    interNode[pos] = oldNode;
+                    best = delta;
+                }
+                rowValue[m + pos] = best;
+            }
+            LS_COUNT(deltaEvaluations, evaluated);
+        };
+        forRows(m, rows);
+        commit(m, 2 * m);
+    }
+
+    // sol[p1 + 1..p2] was reversed: inner rows keep their (mirrored) neighbours,
+    // so with symmetric distances their cached best moves with them; the rows at
+    // both ends of the segment are recomputed
+    void refreshInterReverse(int p1, int p2) {
+        for (int a = p1 + 1, b = p2; a < b; a++, b--) {
+            int valueA = tree.value(m + a), valueB = tree.value(m + b);
+            std::swap(interNode[a], interNode[b]);
+            tree.set(m + a, valueB);
+            tree.set(m + b, valueA);
+        }
+        interRow(p1);
+        interRow(wrap(p1 + 1));
+        interRow(p2);
+        interRow(wrap(p2 + 1));
+    }
+
+private:
+    // Below this many move evaluations a pass runs on the calling thread
+    static constexpr long long PARALLEL_MIN_WORK = 1 << 16;
+
+    // rows(begin, end) over rows 0..m-1, split across the pool for large passes.
+    // Passes only write their own rows' entries, so the split does not change them.
+    template <class Rows>
+    void forRows(long long work, Rows& rows) {
+        if (pool && work >= PARALLEL_MIN_WORK) {
+            pool->run(m, rows);
+        } else {
+            rows(0, m);
+        }
+    }
+
+    // Move the values of leaves first..last-1 computed by a pass into the tree
+    void commit(int first, int last) {
+        for (int leaf = first; leaf < last; leaf++) {
+            if (rowValue[leaf] != tree.value(leaf)) tree.set(leaf, rowValue[leaf]);
+        }
+    }
+
+    int intraRowBest(int i) {
+        int best = INT_MAX, column = -1;
+        for (int j = i + 1; j < m; j++) {
+            int delta = Intra::delta(sol, i, j, distance);
+            if (delta < best) {
+                best = delta;
+                column = j;
+            }
+        }
+        intraColumn[i] = column;
+        LS_COUNT(deltaEvaluations, m - 1 - i);
+        return best;
+    }
+
+    int interRowBest(int pos) {
+        int prev = sol[wrap(pos - 1)], curr = sol[pos], next = sol[wrap(pos + 1)];
+        int removed = distance[prev][curr] + distance[curr][next] + costs[curr];
+        ExchangeDelta best = bestExchange(unselected, prev, next, removed, distance);
+        interNode[pos] = best.node;
+        LS_COUNT(deltaEvaluations, unselected.size());
+        return best.delta;
+    }
+
+    void interRow(int pos) {
+        tree.set(m + pos, interRowBest(pos));
+    }
+
+    const std::vector<int>& sol;
+    const DistanceMatrix& distance;
+    const std::vector<int>& costs;
+    WorkerPool* pool;                // nullptr: every pass on the calling thread
+    ExchangeCandidates& unselected;
+    int m;
+    MinTree& tree;                   // leaves: intra rows 0..m-1, then inter rows
+    std::vector<int>& rowValue;      // leaf values computed by the last pass, before commit()
+    std::vector<int>& intraColumn;   // best j of row i, -1 if the row is empty
+    std::vector<int>& interNode;     // best unselected node of row pos, -1 if none
+    std::vector<bool>& dirty;        // positions passed to refreshIntra
+};
+
+// Steepest over the full neighbourhood, through SteepestRows
+template <class Intra>
+void steepestFull(LSWorkspace& workspace, const DistanceMatrix& distance, const std::vector<int>& costs) {
+    std::vector<int>& sol = workspace.solution;
+    std::vector<int>& changed = workspace.positions;
+
+    // Same moves as a full scan of both neighbourhoods every iteration; lazy
+    // matrices mutate their row cache on lookup, so they are scanned by one thread
+    WorkerPool* pool = distance.storage() == DistanceStorage::Lazy ? nullptr : workspace.pool.get();
+    SteepestRows<Intra> rows(workspace, distance, costs, pool);
+    long long intraMoves = 0, exchangeMoves = 0;
+    while (rows.bestDelta() < 0) {
+        int pos = rows.bestRow(), other = rows.bestColumn();
+        if (rows.bestIsIntra()) {
+            intraMoves++;
+            Intra::apply(sol, pos, other);
+            if constexpr (std::is_same<Intra, ReverseSegment>::value) {
+                // Edges pos..other are new or reversed
+                changed.resize(other - pos + 1);
+                std::iota(changed.begin(), changed.end(), pos);
+                rows.refreshIntra(changed);
+                rows.refreshInterReverse(pos, other);
+            } else {
+                // Entries reading either position or its neighbours change
+                changed.assign({rows.wrap(pos - 1), pos, rows.wrap(pos + 1),
+                                rows.wrap(other - 1), other, rows.wrap(other + 1)});
+                rows.refreshIntra(changed);
+                rows.refreshInterRows(changed);
+            }
+        } else {
+            // Inter-route: exchange nodes
+            exchangeMoves++;
+            int oldNode = sol[pos];
+            sol[pos] = other;
+            if constexpr (std::is_same<Intra, ReverseSegment>::value) {
+                // Intra entry (i, j) reads the edges leaving positions i and j
+                changed.assign({rows.wrap(pos - 1), pos});
+            } else {
+                changed.assign({rows.wrap(pos - 1), pos, rows.wrap(pos + 1)});
+            }
+            rows.refreshIntra(changed);
+            rows.refreshInterExchange(pos, oldNode, other);
+        }
+    }
+    LS_COUNT(improvingMoves, intraMoves + exchangeMoves);
+    LS_COUNT(intraApplied, intraMoves);
+    LS_COUNT(exchangeApplied, exchangeMoves);
+}
+
+// Steepest over the moves adding a candidate edge, enumerated from the
+// neighbour lists every iteration; a pair met twice has the same delta, so it
+// never replaces the best with the strict comparison
+template <class Restriction>
+void steepestCandidates(LSWorkspace& workspace, const DistanceMatrix& distance, const std::vector<int>& costs,
+                        int n, const Restriction& restriction) {
+    const std::vector<std::vector<int>>& nearestNeighbors = restriction.nearestNeighbors;
+    std::vector<int>& sol = workspace.solution;
+    std::vector<bool>& inSolution = workspace.inSolution;
+    int m = sol.size();
+
+    // Build position map for quick lookup
+    std::vector<int>& nodePosition = workspace.position;
+    nodePosition.assign(n, -1);
+    for (int i = 0; i < m; i++) {
+        nodePosition[sol[i]] = i;
+    }
+
+    long long evaluated = 0, checks = 0, intraMoves = 0, exchangeMoves = 0;
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        int bestDelta = 0;
+        int bestType = -1; // 0: intra-reverse, 1: inter-exchange
+        int bestPos1 = -1, bestPos2 = -1, bestNode = -1;
+
+        // A 2-opt move between positions i and j introduces the edges (sol[i], sol[j])
+        // and (sol[i+1], sol[j+1]); at least one must be a candidate edge
+        auto offerIntra = [&](int i, int j) {
+            if (i == j || (i + 1) % m == j) return;
+            int pos1 = std::min(i, j);
+            int pos2 = std::max(i, j);
+            int delta = deltaReverseSegment(sol, pos1, pos2, distance);
+            evaluated++;
+            if (delta < bestDelta) {
+                bestDelta = delta;
+                bestType = 0;
+                bestPos1 = pos1;
+                bestPos2 = pos2;
+            }
+        };
+        for (int i = 0; i < m; i++) {
+            checks += nearestNeighbors[sol[i]].size() + nearestNeighbors[sol[(i + 1) % m]].size();
+            // Case 1: (sol[i], sol[j]) is a candidate edge
+            for (int neighbor : nearestNeighbors[sol[i]]) {
+                if (inSolution[neighbor]) offerIntra(i, nodePosition[neighbor]);
+            }
+            // Case 2: (sol[i+1], sol[j+1]) is a candidate edge
+            for (int neighbor : nearestNeighbors[sol[(i + 1) % m]]) {
+                if (inSolution[neighbor]) offerIntra(i, (nodePosition[neighbor] - 1 + m) % m);
+            }
+        }
+
+        // Exchanging node at pos introduces edges (sol[prev], newNode) and (newNode, sol[next])
+        auto offerInter = [&](int pos, int newNode) {
+            int delta = deltaExchangeNodes(sol, pos, newNode, distance, costs);
+            evaluated++;
+            if (delta < bestDelta) {
+                bestDelta = delta;
+                bestType = 1;
+                bestPos1 = pos;
+                bestNode = newNode;
+            }
+        };
+        for (int pos = 0; pos < m; pos++) {
+            checks += nearestNeighbors[sol[(pos - 1 + m) % m]].size() + nearestNeighbors[sol[(pos + 1) % m]].size();
+            for (int newNode : nearestNeighbors[sol[(pos - 1 + m) % m]]) {
+                if (!inSolution[newNode]) offerInter(pos, newNode);
+            }
+            for (int newNode : nearestNeighbors[sol[(pos + 1) % m]]) {
+                if (!inSolution[newNode]) offerInter(pos, newNode);
+            }
+        }
+
+        // Apply best move
+        if (bestDelta < 0) {
+            improved = true;
+            if (bestType == 0) {
+                intraMoves++;
+                ReverseSegment::apply(sol, bestPos1, bestPos2);
+                for (int i = bestPos1 + 1; i <= bestPos2; i++) {
+                    nodePosition[sol[i]] = i;
+                }
+            } else {
+                exchangeMoves++;
+                int oldNode = sol[bestPos1];
+                inSolution[oldNode] = false;
+                inSolution[bestNode] = true;
+                sol[bestPos1] = bestNode;
+                nodePosition[oldNode] = -1;
+                nodePosition[bestNode] = bestPos1;
+            }
+        }
+    }
+    LS_COUNT(deltaEvaluations, evaluated);
+    LS_COUNT(candidateChecks, checks);
+    LS_COUNT(improvingMoves, intraMoves + exchangeMoves);
+    LS_COUNT(intraApplied, intraMoves);
+    LS_COUNT(exchangeApplied, exchangeMoves);
+}
+
+// Unordered pair number k of the m * (m - 1) / 2 pairs of positions: position
+// i with i + d (mod m) for d = 1..(m - 1) / 2, then for even m the m / 2 pairs
+// of opposite positions; returned with i < j
+inline void decodePair(long long k, int m, int& i, int& j) {
+    long long half = (m - 1) / 2;
+    int d;
+    if (k < m * half) {
+        i = (int)(k % m);
+        d = (int)(1 + k / m);
+    } else {
+        i = (int)(k - m * half);
+        d = m / 2;
+    }
+    j = (i + d) % m;
+    if (i > j) std::swap(i, j);
+}
+
+// Greedy descent: move k < m * |unselected| exchanges position k / |unselected|
+// with unselected node k % |unselected|; the rest are intra pairs (decodePair)
+template <class Intra>
+void greedyFull(LSWorkspace& workspace, const DistanceMatrix& distance, const std::vector<int>& costs,
+                int n, std::mt19937& rng) {
+    std::vector<int>& sol = workspace.solution;
+    int solSize = sol.size();
+
+    // Exchanges put the removed node in the slot of the added one, so the list
+    // stays the set of non-selected nodes without being rebuilt
+    std::vector<int>& nonSelected = workspace.nonSelected;
+    nonSelected.clear();
+    for (int i = 0; i < n; i++) {
+        if (!workspace.inSolution[i]) nonSelected.push_back(i);
+    }
+
+    // Past n of about 90000 these overflow an int
+    long long numInter = (long long)solSize * nonSelected.size();
+    long long totalMoves = numInter + (long long)solSize * (solSize - 1) / 2;
+    RandomMoveOrder& order = workspace.order;
+
+    long long evaluated = 0, intraMoves = 0, exchangeMoves = 0;
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        order.restart(totalMoves);
+        while (!improved && !order.done()) {
+            long long moveIdx = order.next(rng);
+            evaluated++;
+            if (moveIdx < numInter) {
+                int pos = (int)(moveIdx / (long long)nonSelected.size());
+                int nodeIdx = (int)(moveIdx % (long long)nonSelected.size());
+                int node = nonSelected[nodeIdx];
+                if (deltaExchangeNodes(sol, pos, node, distance, costs) < 0) {
+                    nonSelected[nodeIdx] = sol[pos];
+                    sol[pos] = node;
+                    exchangeMoves++;
+                    improved = true;
+                }
+            } else {
+                int i, j;
+                decodePair(moveIdx - numInter, solSize, i, j);
+                if (Intra::delta(sol, i, j, distance) < 0) {
+                    Intra::apply(sol, i, j);
+                    intraMoves++;
+                    improved = true;
+                }
+            }
+        }
+    }
+    LS_COUNT(deltaEvaluations, evaluated);
+    LS_COUNT(improvingMoves, intraMoves + exchangeMoves);
+    LS_COUNT(intraApplied, intraMoves);
+    LS_COUNT(exchangeApplied, exchangeMoves);
+}
+
+inline void buildNodePositions(const std::vector<int>& sol, std::vector<int>& nodePos) {
+    std::fill(nodePos.begin(), nodePos.end(), -1);
+    for (int i = 0; i < (int)sol.size(); ++i) {
+        nodePos[sol[i]] = i;
+    }
+}
+
+// 2-opt between positions i < j keeping nodePos: reverses sol[i + 1..j], or
+// when that is over half of the cycle the rest of it, sol[j + 1..i] wrapping
+// around; either way the tour gets the same edges. O(min(j - i, m - j + i)).
+inline void reverseShorterSide(std::vector<int>& sol, std::vector<int>& nodePos, int i, int j) {
+    int m = sol.size();
+    int from = i + 1, length = j - i;
+    if (2 * length > m) {
+        from = j + 1;
+        length = m - length;
+    }
+    for (int p = from, q = from + length - 1; p < q; p++, q--) {
+        int x = p % m, y = q % m;
+        std::swap(sol[x], sol[y]);
+        nodePos[sol[x]] = x;
+        nodePos[sol[y]] = y;
+    }
+}
+
+// Check edge existence AND orientation
+// a_to_b = true if a->b, false if b->a
+inline bool edgeExistsUndirected(const std::vector<int>& sol,
+                                 const std::vector<int>& nodePos,
+                                 int a, int b,
+                                 bool &a_to_b) {
+    int sz = (int)sol.size();
+    int pa = nodePos[a];
+    if (pa >= 0) {
+        int na = (pa + 1) % sz;
+        if (sol[na] == b) { a_to_b = true; return true; }
+    }
+    int pb = nodePos[b];
+    if (pb >= 0) {
+        int nb = (pb + 1) % sz;
+        if (sol[nb] == a) { a_to_b = false; return true; }
+    }
+    return false;
+}
+
+// Improving moves of the edges leaving the given positions, appended in scan order
+template <class Restriction>
+void generateMovesForNodes(
+    const std::vector<int>& nodesToScan,
+    const std::vector<int>& sol,
+    const ExchangeCandidates& unselected,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    const Restriction& restriction,
+    std::vector<LMMove>& moves,
+    std::vector<ExchangeDelta>& exchanges,
+    bool useSymmetryCheck
+) {
+    int sz = (int)sol.size();
+    size_t generatedFrom = moves.size();
+    long long evaluated = 0, checks = 0;
+
+    for (int iPos : nodesToScan) {
+        int u = sol[iPos];
+        int v = sol[(iPos + 1) % sz]; // Edge u-v
+
+        // 1. Intra-route 2-opt
+        for (int j = 0; j < sz; ++j) {
+            // Skip adjacent edges (cannot 2-opt with yourself or neighbor)
+            if (iPos == j || (iPos + 1) % sz == j || (j + 1) % sz == iPos) continue;
+
+            int x = sol[j];
+            int y = sol[(j + 1) % sz]; // Edge x-y
+
+            // Only apply symmetry optimization if we are scanning EVERY node (Initialization).
+            // If we are updating (partial scan), we MUST check u > x because x might not be in 'nodesToScan'.
+            if (useSymmetryCheck && u > x) continue;
+            if constexpr (Restriction::restricted) checks += 2;
+
+            // VARIANT A: Parallel (Standard)
+            // Assumes directions: u->v AND x->y
+            if (restriction.isCandidateEdge(u, x) || restriction.isCandidateEdge(v, y)) {
+                int deltaA = deltaExchangeEdges(u, v, x, y, distance);
+                evaluated++;
+                if (deltaA < 0) {
+                    moves.push_back({0, u, v, x, y, -1, deltaA});
+                }
+            }
+
+            // VARIANT B: Inverted/Twisted
+            // Assumes directions: u->v AND y->x
+            // We store it as edge (y, x) so the checker looks for y->x
+            if (restriction.isCandidateEdge(u, y) || restriction.isCandidateEdge(v, x)) {
+                int deltaB = deltaExchangeEdges(u, v, y, x, distance);
+                evaluated++;
+                if (deltaB < 0) {
+                    moves.push_back({0, u, v, y, x, -1, deltaB});
+                }
+            }
+        }
+
+        // 2. Inter-route Exchange
+        // Replace sol[iPos] (curr) with 'node', improving ones in node order
+        int prev = sol[(iPos - 1 + sz) % sz];
+        int curr = sol[iPos];
+        int next = sol[(iPos + 1) % sz];
+        int oldCost = distance[prev][curr] + distance[curr][next] + costs[curr];
+        if constexpr (!Restriction::restricted) {
+            exchanges.clear();
+            improvingExchanges(unselected, prev, next, oldCost, distance, exchanges);
+            evaluated += unselected.size();
+            for (const ExchangeDelta& exchange : exchanges) {
+                moves.push_back({1, prev, curr, curr, next, exchange.node, exchange.delta});
+            }
+        } else {
+            checks += unselected.size();
+            for (int i = 0; i < unselected.size(); ++i) {
+                int node = unselected.nodes()[i];
+                if (!restriction.isCandidateEdge(prev, node) && !restriction.isCandidateEdge(node, next)) continue;
+                evaluated++;
+                int newCost = distance[prev][node] + distance[node][next] + costs[node];
+                int delta = newCost - oldCost;
+                if (delta < 0) {
+                    moves.push_back({1, prev, curr, curr, next, node, delta});
+                }
+            }
+        }
+    }
+    LS_COUNT(deltaEvaluations, evaluated);
+    LS_COUNT(candidateChecks, checks);
+    LS_COUNT(improvingMoves, moves.size() - generatedFrom);
+}
+
+// Steepest with a list of improving moves, kept as a binary heap on
+// LMMove::operator<: moves are popped best first, moves whose edges are gone
+// are dropped, moves whose edges are present with different relative
+// directions are held and pushed back after the step, and the first applicable
+// move is applied; then only moves around the touched positions are generated
+// and pushed. Invalid moves are deleted lazily, when they reach the top, so a
+// step costs O(log |LM|) per move pushed or popped instead of a pass over the
+// whole list. The position map is updated only where the move changed the
+// tour. The checks compare relative directions only, so a 2-opt may reverse
+// either side of the cycle.
+template <class Restriction>
+void moveList(LSWorkspace& workspace, const DistanceMatrix& distance, const std::vector<int>& costs,
+              int n, const Restriction& restriction) {
+    std::vector<int>& sol = workspace.solution;
+    int sz = (int)sol.size();
+
+    std::vector<bool>& inSolution = workspace.inSolution;
+    ExchangeCandidates& unselected = workspace.unselected;
+    unselected.reset(inSolution, costs);
+
+    std::vector<int>& nodePos = workspace.position;
+    nodePos.resize(n);
+    buildNodePositions(sol, nodePos);
+
+    // Max-heap order of std::push_heap reversed: the best move on top
+    auto worse = [](const LMMove& a, const LMMove& b) { return b < a; };
+    std::vector<LMMove>& LM = workspace.moves;
+    LM.clear();
+    int nextSeq = 0;
+
+    // --- PHASE 1: INITIALIZATION ---
+    // We scan ALL nodes here, so we CAN use the symmetry check to save time.
+    std::vector<int>& allIndices = workspace.positions;
+    allIndices.resize(sz);
+    for (int i = 0; i < sz; ++i) allIndices[i] = i;
+
+    generateMovesForNodes(allIndices, sol, unselected, distance, costs, restriction, LM, workspace.exchanges, true);
+    for (LMMove& m : LM) m.seq = nextSeq++;
+    std::make_heap(LM.begin(), LM.end(), worse);
+    LS_COUNT_MAX(listHighWater, LM.size());
+    long long stale = 0, intraMoves = 0, exchangeMoves = 0;
+
+    // --- PHASE 2: MAIN LOOP ---
+    std::vector<LMMove>& held = workspace.heldMoves;
+    bool improved = true;
+    while (improved) {
+        improved = false;
+
+        LMMove appliedMove;
+        bool moveFound = false;
+        held.clear();
+
+        while (!LM.empty()) {
+            std::pop_heap(LM.begin(), LM.end(), worse);
+            LMMove m = LM.back();
+            LM.pop_back();
+
+            // Exchange Check
+            if (m.type == 1 && inSolution[m.newNode]) {
+                stale++;
+                continue;
+            }
+
+            bool dir1, dir2;
+            bool exists1 = edgeExistsUndirected(sol, nodePos, m.a1, m.b1, dir1);
+            bool exists2 = edgeExistsUndirected(sol, nodePos, m.a2, m.b2, dir2);
+
+            // REQ 1: Edges gone -> Remove
+            if (!exists1 || !exists2) {
+                stale++;
+                continue;
+            }
+
+            // REQ 2: Different relative direction -> Leave but don't apply
+            if (dir1 != dir2) {
+                held.push_back(m);
+                continue;
+            }
+
+            // REQ 3: Same direction -> Apply
+            moveFound = true;
+            appliedMove = m;
+
+            if (appliedMove.type == 0) { // 2-opt
+                int u = dir1 ? nodePos[appliedMove.a1] : nodePos[appliedMove.b1];
+                int v = dir2 ? nodePos[appliedMove.a2] : nodePos[appliedMove.b2];
+                if (u > v) std::swap(u, v);
+                reverseShorterSide(sol, nodePos, u, v);
+                intraMoves++;
+            } else { // Exchange
+                int pos = nodePos[appliedMove.b1];
+                inSolution[sol[pos]] = false;
+                inSolution[appliedMove.newNode] = true;
+                unselected.exchange(sol[pos], appliedMove.newNode);
+                nodePos[sol[pos]] = -1;
+                nodePos[appliedMove.newNode] = pos;
+                sol[pos] = appliedMove.newNode;
+                exchangeMoves++;
+            }
+            break;
+        }
+
+        // Held moves keep their seq, so they come out in the same order again
+        for (const LMMove& m : held) {
+            LM.push_back(m);
+            std::push_heap(LM.begin(), LM.end(), worse);
+        }
+
+        if (moveFound) {
+            improved = true;
+
+            // --- UPDATE ---
+            std::vector<int>& touched = workspace.positions;
+            if (appliedMove.type == 0) {
+                // Robustly find the new positions of the nodes involved
+                // Note: We can't rely on 'appliedMove.a1' index because orientation might have flipped.
+                // We rely on the node IDs.
+                int p1 = nodePos[appliedMove.a1]; if (p1<0) p1=nodePos[appliedMove.b1];
+                int p2 = nodePos[appliedMove.a2]; if (p2<0) p2=nodePos[appliedMove.b2];
+                // Add neighbors
+                touched.assign({p1, (p1+1)%sz, (p1-1+sz)%sz, p2, (p2+1)%sz, (p2-1+sz)%sz});
+            } else {
+                int pos = nodePos[appliedMove.newNode];
+                touched.assign({pos, (pos - 1 + sz) % sz, (pos + 1) % sz});
+            }
+
+            // Generate NEW moves
+            std::vector<LMMove>& newMoves = workspace.newMoves;
+            newMoves.clear();
+
+            // IMPORTANT: Pass 'false' for useSymmetryCheck here!
+            // We must check (touched vs ALL), even if touched > other.
+            generateMovesForNodes(touched, sol, unselected, distance, costs, restriction, newMoves,
+                                  workspace.exchanges, false);
+
+            for (LMMove& m : newMoves) {
+                m.seq = nextSeq++;
+                LM.push_back(m);
+                std::push_heap(LM.begin(), LM.end(), worse);
+            }
+            LS_COUNT_MAX(listHighWater, LM.size());
+        }
+    }
+    LS_COUNT(staleDiscarded, stale);
+    LS_COUNT(intraApplied, intraMoves);
+    LS_COUNT(exchangeApplied, exchangeMoves);
+}
+
+}
+
+// Search from initialSolution (which may be workspace.solution) into workspace.solution
+template <class Selection, class Intra, class Restriction = FullNeighborhood>
+const std::vector<int>& localSearchEngine(
+    const std::vector<int>& initialSolution,
+    const DistanceMatrix& distance,
+    const std::vector<int>& costs,
+    int n,
+    const Selection& selection,
+    LSWorkspace& workspace,
+    const Restriction& restriction = Restriction()
+) {
+    using namespace localSearchDetail;
+    workspace.start(initialSolution, n);
+    if constexpr (std::is_same<Selection, Steepest>::value) {
+        if constexpr (Restriction::restricted) {
+            // The candidate enumeration follows the new edges of a 2-opt move
+            static_assert(std::is_same<Intra, ReverseSegment>::value, "candidate steepest needs ReverseSegment");
+            steepestCandidates(workspace, distance, costs, n, restriction);
+        } else {
+            steepestFull<Intra>(workspace, distance, costs);
+        }
+    } else if constexpr (std::is_same<Selection, Greedy>::value) {
+        static_assert(!Restriction::restricted, "greedy search draws from the full neighbourhood");
+        greedyFull<Intra>(workspace, distance, costs, n, selection.rng);
+    } else {
+        static_assert(std::is_same<Selection, MoveList>::value, "unknown selection policy");
+        static_assert(std::is_same<Intra, ReverseSegment>::value, "the move list stores 2-opt moves by edges");
+        moveList(workspace, distance, costs, n, restriction);
+    }
+    return workspace.solution;
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef LOCAL_SEARCH_WORKSPACE_H
+#define LOCAL_SEARCH_WORKSPACE_H
+
+#include <vector>
+#include <memory>
+#include "minTree.h"
+#include "exchangeScan.h"
+#include "randomMoveOrder.h"
+#include "twoLevelTour.h"
+#include "workerPool.h"
+
+// Improving move of the list-of-moves search, stored by its edges: 2-opt
+// removes (a1, b1) and (a2, b2); an exchange replaces b1 = a2 (between a1 and
+// b2) with newNode
+struct LMMove {
+    int type; // 0 = 2-opt, 1 = exchange
+    int a1, b1;
+    int a2, b2;
+    int newNode;
+    int delta;
+    int seq = 0;  // order of insertion into the list, set by the search
+
+    // Sort by Delta: Most negative (best improvement) first; earlier moves
+    // first among equal ones
+    bool operator<(const LMMove& other) const {
+        if (delta != other.delta) return delta < other.delta;
+        if (type != other.type) return type < other.type;
+        if (a1 != other.a1) return a1 < other.a1;
+        return seq < other.seq;
+    }
+};
+
+// Buffers of the local searches, kept between calls. A search given a
+// workspace starts from start(), resizes what it uses to the instance and
+// leaves its result in solution; vectors keep their capacity, so once the
+// first searches on an instance have sized them, repeated searches do not
+// allocate. One workspace per thread; the searches without one build a
+// temporary workspace per call.
+struct LSWorkspace {
+    LSWorkspace() = default;
+    // Reserve for searches on an instance of n nodes
+    explicit LSWorkspace(int n);
+
+    // solution = initialSolution (which may be solution itself), inSolution over n nodes
+    void start(const std::vector<int>& initialSolution, int n);
+
+    // Evaluate the steepest neighbourhoods on threads threads (the caller's
+    // included) from now on; 1 drops the pool
+    void setThreads(int threads);
+
+    std::vector<int> solution;      // current solution, the result after the search
+    std::vector<bool> inSolution;
+    std::vector<int> position;      // position in solution, -1 if not selected
+    std::vector<int> positions;     // positions changed by the last move
+
+    // Steepest: cached rows (localSearchDetail::SteepestRows)
+    ExchangeCandidates unselected;
+    MinTree tree;
+    std::vector<int> rowValue;
+    std::vector<int> intraColumn;
+    std::vector<int> interNode;
+    std::vector<bool> dirty;
+
+    // Greedy
+    std::vector<int> nonSelected;
+    RandomMoveOrder order;
+
+    // List of moves: the heap, the moves of the last step, moves held back
+    std::vector<LMMove> moves;
+    std::vector<LMMove> newMoves;
+    std::vector<LMMove> heldMoves;
+    std::vector<ExchangeDelta> exchanges;
+
+    // Don't-look bits: array tour (or the two-level tour of large tours) and
+    // the queue of awake nodes
+    std::vector<int> tour;
+    TwoLevelTour twoLevelTour;
+    std::vector<int> queue;
+    std::vector<bool> queued;
+
+    std::unique_ptr<WorkerPool> pool;   // set by setThreads, nullptr for one thread
+};
+
+#endif
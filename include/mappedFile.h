@@ -0,0 +1,30 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <memory>
+#include <cstddef>
+
+// Read-only view of a whole file. Uses mmap on POSIX systems (pages are
+// faulted in lazily) and falls back to reading the file into memory elsewhere.
+class MappedFile {
+public:
+    // Returns nullptr if the file cannot be opened or is empty
+    static std::shared_ptr<MappedFile> open(const std::string& filename);
+
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return begin; }
+    size_t size() const { return length; }
+
+private:
+    MappedFile() = default;
+
+    const char* begin = nullptr;
+    size_t length = 0;
+    bool mapped = false;
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef MIN_TREE_H
+#define MIN_TREE_H
+
+#include <vector>
+
+// Tournament tree over a fixed number of int leaves: each inner node keeps the
+// leaf that wins its subtree, the smaller value and on ties the leftmost leaf,
+// so minLeaf() is the leaf a scan from 0 with a strict < would pick. set() is
+// O(log n), minLeaf() O(1). Leaves start at INT_MAX.
+class MinTree {
+public:
+    MinTree() = default;
+    explicit MinTree(int leaves);
+
+    // All leaves back to INT_MAX; the storage is kept when it is large enough
+    void reset(int leaves);
+
+    void set(int leaf, int value);
+    int value(int leaf) const { return values[leaf]; }
+
+    int minLeaf() const { return winner[1]; }
+    int minValue() const { return values[winner[1]]; }
+
+private:
+    int better(int a, int b) const { return values[b] < values[a] ? b : a; }
+
+    int width = 1;             // leaves rounded up to a power of two
+    std::vector<int> values;   // per leaf, padding leaves included
+    std::vector<int> winner;   // winning leaf per node, root at 1, leaves at width..2*width-1
+};
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef MOVE_DELTAS_H
+#define MOVE_DELTAS_H
+
+#include <vector>
+#include <algorithm>
+#include "distanceMatrix.h"
+
+// Objective deltas of the local search moves on a cycle stored as positions
+
+// Calculate delta for swapping two nodes in the cycle (intra-route)
+inline int deltaSwapNodes(const std::vector<int>& sol, int pos1, int pos2,
+                          const DistanceMatrix& distance) {
+    int n = sol.size();
+    if (pos1 == pos2) return 0;
+    if (pos1 > pos2) std::swap(pos1, pos2);
+
+    int prev1 = (pos1 - 1 + n) % n;
+    int next1 = (pos1 + 1) % n;
+    int prev2 = (pos2 - 1 + n) % n;
+    int next2 = (pos2 + 1) % n;
+
+    // Handle adjacent nodes specially
+    if (next1 == pos2) {
+        // Nodes are adjacent: prev1-pos1-pos2-next2
+        int oldCost = distance[sol[prev1]][sol[pos1]] +
+                      distance[sol[pos1]][sol[pos2]] +
+                      distance[sol[pos2]][sol[next2]];
+        int newCost = distance[sol[prev1]][sol[pos2]] +
+                      distance[sol[pos2]][sol[pos1]] +
+                      distance[sol[pos1]][sol[next2]];
+        return newCost - oldCost;
+    }
+
+    // Handle wraparound case: pos2-pos1 are adjacent (pos2 followed by pos1)
+    if (next2 == pos1) {
+        // Nodes are adjacent with wraparound: prev2-pos2-pos1-next1
+        int oldCost = distance[sol[prev2]][sol[pos2]] +
+                      distance[sol[pos2]][sol[pos1]] +
+                      distance[sol[pos1]][sol[next1]];
+        int newCost = distance[sol[prev2]][sol[pos1]] +
+                      distance[sol[pos1]][sol[pos2]] +
+                      distance[sol[pos2]][sol[next1]];
+        return newCost - oldCost;
+    }
+
+    // Non-adjacent nodes
+    int oldCost = distance[sol[prev1]][sol[pos1]] + distance[sol[pos1]][sol[next1]] +
+                  distance[sol[prev2]][sol[pos2]] + distance[sol[pos2]][sol[next2]];
+    int newCost = distance[sol[prev1]][sol[pos2]] + distance[sol[pos2]][sol[next1]] +
+                  distance[sol[prev2]][sol[pos1]] + distance[sol[pos1]][sol[next2]];
+    return newCost - oldCost;
+}
+
+// Calculate delta for reversing segment (two-edges exchange, intra-route)
+inline int deltaReverseSegment(const std::vector<int>& sol, int pos1, int pos2,
+                               const DistanceMatrix& distance) {
+    int n = sol.size();
+    if (pos1 == pos2 || (pos1 + 1) % n == pos2) return 0;
+
+    // Remove edges at boundaries and add new edges ---pos1x-----pos2x---- -> ---pos1pos2-----xx----
+    int oldCost = distance[sol[pos1]][sol[(pos1 + 1) % n]] +
+                  distance[sol[pos2]][sol[(pos2 + 1) % n]];
+    int newCost = distance[sol[pos1]][sol[pos2]] +
+                  distance[sol[(pos1 + 1) % n]][sol[(pos2 + 1) % n]];
+    return newCost - oldCost;
+}
+
+// Calculate delta for exchanging selected node with non-selected node (inter-route)
+inline int deltaExchangeNodes(const std::vector<int>& sol, int pos, int newNode,
+                              const DistanceMatrix& distance,
+                              const std::vector<int>& costs) {
+    int n = sol.size();
+    int prev = (pos - 1 + n) % n;
+    int next = (pos + 1) % n;
+
+    int oldCost = distance[sol[prev]][sol[pos]] + distance[sol[pos]][sol[next]] + costs[sol[pos]];
+    int newCost = distance[sol[prev]][newNode] + distance[newNode][sol[next]] + costs[newNode];
+    return newCost - oldCost;
+}
+
+// Delta of removing edges (u, v) and (x, y) and adding (u, x) and (v, y), by node
+inline int deltaExchangeEdges(int u, int v, int x, int y, const DistanceMatrix& dist) {
+    return (dist[u][x] + dist[v][y]) - (dist[u][v] + dist[x][y]);
+}
+
+#endif
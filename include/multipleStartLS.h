@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <random>
+#include "distanceMatrix.h"
 
 struct MSLSResult {
     std::vector<int> bestSolution;
@@ -15,7 +16,7 @@ struct MSLSResult {
 MSLSResult multipleStartLS(
     int n,
     int selectCount,
-    const std::vector<std::vector<int>>& distance,
+    const DistanceMatrix& distance,
     const std::vector<int>& costs,
     const std::vector<std::vector<int>>& randomInitials,
     int iterations,
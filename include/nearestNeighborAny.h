@@ -2,7 +2,8 @@
 #define NEAREST_NEIGHBOR_ANY_H
 
 #include <vector>
+#include "distanceMatrix.h"
 
-std::vector<int> nearestNeighborAny(int startNode, int selectCount, const std::vector<std::vector<int>>& distance, const std::vector<int>& costs);
+std::vector<int> nearestNeighborAny(int startNode, int selectCount, const DistanceMatrix& distance, const std::vector<int>& costs);
 
 #endif
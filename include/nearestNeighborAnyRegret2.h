@@ -2,7 +2,8 @@
 #define NEAREST_NEIGHBOR_ANY_REGRET2_H
 
 #include <vector>
+#include "distanceMatrix.h"
 
-std::vector<int> nearestNeighborAnyRegret2(int startNode, int selectCount, const std::vector<std::vector<int>>& distance, const std::vector<int>& costs);
+std::vector<int> nearestNeighborAnyRegret2(int startNode, int selectCount, const DistanceMatrix& distance, const std::vector<int>& costs);
 
 #endif
@@ -2,7 +2,8 @@
 #define NEAREST_NEIGHBOR_ANY_REGRET2_WEIGHTED_H
 
 #include <vector>
+#include "distanceMatrix.h"
 
-std::vector<int> nearestNeighborAnyRegret2Weighted(int startNode, int selectCount, const std::vector<std::vector<int>>& distance, const std::vector<int>& costs, double wRegret = 1.0, double wBest = 1.0);
+std::vector<int> nearestNeighborAnyRegret2Weighted(int startNode, int selectCount, const DistanceMatrix& distance, const std::vector<int>& costs, double wRegret = 1.0, double wBest = 1.0);
 
 #endif
@@ -2,7 +2,16 @@
 #define NEAREST_NEIGHBOR_END_H
 
 #include <vector>
+#include "distanceMatrix.h"
+#include "constructionBatch.h"
 
-std::vector<int> nearestNeighborEnd(int startNode, int selectCount, const std::vector<std::vector<int>>& distance, const std::vector<int>& costs);
+// ranking (optional) replaces the scan for the next node with a walk along the last node's ranked neighbours
+std::vector<int> nearestNeighborEnd(int startNode, int selectCount, const DistanceMatrix& distance, const std::vector<int>& costs,
+                                    const NeighborRanking* ranking = nullptr);
+
+// nearestNeighborEnd for every start, sharing the caller's ranking (same solutions).
+// The per-start times do not include building the ranking.
+BatchSolutions nearestNeighborEndBatch(const std::vector<int>& starts, int selectCount, const DistanceMatrix& distance,
+                                       const std::vector<int>& costs, const NeighborRanking& ranking, int threads = 1);
 
 #endif
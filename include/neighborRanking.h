@@ -0,0 +1,57 @@
+#ifndef NEIGHBOR_RANKING_H
+#define NEIGHBOR_RANKING_H
+
+#include <vector>
+#include <climits>
+#include "distanceMatrix.h"
+
+// For every node u, the other nodes ordered by distance[u][v] + costs[v]
+// (ties: smaller v), which is the order in which a scan for the cheapest node
+// to append after u ranks them. Only the first width() entries of each row
+// are kept; cheapestUnselected() falls back to a full scan once those are
+// exhausted. Built once per instance and shared read-only by all starts and
+// threads.
+class NeighborRanking {
+public:
+    // Number of ranked neighbours kept per node by default
+    static constexpr int DEFAULT_WIDTH = 256;
+
+    NeighborRanking(const DistanceMatrix& distance, const std::vector<int>& costs, int width = DEFAULT_WIDTH);
+
+    int width() const { return rowWidth; }
+    const int* row(int node) const { return order.data() + (size_t)node * rowWidth; }
+
+private:
+    int rowWidth;
+    std::vector<int> order;
+};
+
+// Cheapest node to append after node: smallest distance[node][v] + costs[v]
+// over !selected[v] (ties: smaller v), -1 if every node is selected. node
+// itself must be selected. With a ranking, this walks past the selected
+// entries of node's row, which on typical instances is a few steps; without
+// one (or past the kept prefix) it scans all n nodes.
+template <class Selected>
+int cheapestUnselected(int node, const Selected& selected, const DistanceMatrix& distance,
+                       const std::vector<int>& costs, const NeighborRanking* ranking) {
+    if (ranking) {
+        const int* row = ranking->row(node);
+        for (int k = 0; k < ranking->width(); k++) {
+            if (!selected[row[k]]) return row[k];
+        }
+    }
+    int bestNode = -1;
+    int bestDelta = INT_MAX;
+    DistanceMatrix::Row distances = distance[node];
+    for (int i = 0; i < distance.size(); i++) {
+        if (selected[i]) continue;
+        int delta = distances[i] + costs[i];
+        if (delta < bestDelta) {
+            bestDelta = delta;
+            bestNode = i;
+        }
+    }
+    return bestNode;
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef RANDOM_MOVE_ORDER_H
+#define RANDOM_MOVE_ORDER_H
+
+#include <vector>
+#include <random>
+
+// Indices 0..count-1 in a uniformly random order, drawn one at a time: a
+// Fisher-Yates shuffle that only materialises the slots it has swapped. Up to
+// DENSE_LIMIT they go into arrays indexed by slot; past it, where count may be
+// the m (n - m) + m^2 / 2 moves of a large instance, into a hash table that
+// holds the displaced slots not drawn yet, so memory follows the number of
+// draws instead. Slots written in an earlier round are told apart by a round
+// stamp, so restart() is O(1) and the buffers are reused for the whole local
+// search.
+class RandomMoveOrder {
+public:
+    // Start a new permutation of 0..count-1
+    void restart(long long count);
+
+    bool done() const { return taken == count; }
+    long long next(std::mt19937& rng);
+
+private:
+    // Largest count kept in the arrays (8 bytes per index)
+    static constexpr long long DENSE_LIMIT = 1 << 22;
+
+    int slot(int i) const { return stamp[i] == round ? swapped[i] : i; }
+
+    struct Entry {
+        long long slot;
+        long long value;
+        unsigned round = 0;   // 0: never current
+    };
+
+    size_t home(long long slot) const { return (size_t)((unsigned long long)slot * 0x9E3779B97F4A7C15ull >> shift); }
+    bool current(size_t index) const { return table[index].round == round; }
+    // Index of slot's entry in this round, or table.size() if it holds its own index
+    size_t find(long long slot) const;
+    // Set slot's entry to value and return what it held
+    long long exchange(long long slot, long long value);
+    void erase(size_t index);
+    void grow();
+
+    long long count = 0;
+    long long taken = 0;
+    unsigned round = 0;
+    bool dense = true;
+    std::vector<int> swapped;
+    std::vector<unsigned> stamp;   // round in which swapped[i] was written
+
+    size_t used = 0;            // entries of this round
+    int shift = 64;             // 64 - log2(table.size())
+    std::vector<Entry> table;   // open addressing, linear probing; size 0 or a power of two
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef REGRET_QUEUE_H
+#define REGRET_QUEUE_H
+
+#include <vector>
+
+// Indexed max-heap of unselected nodes for the weighted 2-regret constructors.
+// A node ranks higher with a larger score = wRegret * regret - wBest * best1,
+// then (scores within EPSILON) a smaller best1, then a larger regret, then a
+// smaller node index: the node a full scan over 0..n-1 with the constructors'
+// comparison would pick. Keys are updated in place, so top() is O(1) and
+// update()/remove() are O(log n).
+class RegretQueue {
+public:
+    RegretQueue(int n, double wRegret, double wBest);
+
+    // Insert the node or move it to its new key (best2 == INT_MAX means no regret)
+    void update(int node, int best1, int best2);
+    void remove(int node);
+
+    bool empty() const { return heap.empty(); }
+    int top() const { return heap[0]; }
+
+private:
+    struct Key {
+        double score;
+        int best1;
+        int regret;
+    };
+
+    bool before(int a, int b) const;
+    void place(int index, int node);
+    void siftUp(int index);
+    void siftDown(int index);
+
+    double wRegret, wBest;
+    std::vector<Key> keys;
+    std::vector<int> heap;
+    std::vector<int> indexOf;   // index in heap, -1 if not queued
+};
+
+#endif
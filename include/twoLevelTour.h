@@ -0,0 +1,73 @@
+#ifndef TWO_LEVEL_TOUR_H
+#define TWO_LEVEL_TOUR_H
+
+#include <vector>
+
+// Cycle split into about sqrt(m) segments, each with a reversal bit, kept in
+// an ordered list. A 2-opt move splits at most two segments so that the path
+// to reverse is a run of whole segments, then reverses the order of that run
+// (or of its complement, whichever is shorter) and flips their bits: O(sqrt m)
+// instead of the O(m) of reversing an array. The segments are rebuilt once
+// the splits have doubled their number. reset() sizes a pool of segments for
+// all the splits until then, so moves and rebuilds of a tour of the same size
+// never allocate.
+class TwoLevelTour {
+public:
+    TwoLevelTour() = default;
+    explicit TwoLevelTour(int n);
+
+    // Take nodes 0..n-1 from now on; empties the tour if n changes
+    void resize(int n);
+
+    // Replace the tour with the given cycle
+    void reset(const std::vector<int>& nodes);
+
+    int size() const { return count; }
+    bool contains(int node) const { return segmentOf[node] >= 0; }
+    int next(int node) const;
+    int prev(int node) const;
+    // True if b is met walking forward from a to c (all three in the tour, bounds included)
+    bool between(int a, int b, int c) const;
+
+    // Remove edges (a, next(a)) and (c, next(c)), add (a, c) and (next(a), next(c))
+    void twoOptMove(int a, int c);
+    // Put an unselected node in the place of a tour node
+    void replace(int oldNode, int newNode);
+
+    // Nodes in tour order starting from the first node of the first segment
+    std::vector<int> toVector() const;
+    // Same into nodes, reusing its storage
+    void toVector(std::vector<int>& nodes) const;
+
+private:
+    struct Segment {
+        std::vector<int> nodes;   // stored order; tour order is reversed if the bit is set
+        bool reversed = false;
+        int rank = 0;             // index in order
+    };
+
+    int nodeAt(const Segment& segment, int position) const {
+        int index = segment.reversed ? (int)segment.nodes.size() - 1 - position : position;
+        return segment.nodes[index];
+    }
+    int positionOf(int node) const {
+        const Segment& segment = segments[segmentOf[node]];
+        return segment.reversed ? (int)segment.nodes.size() - 1 - indexOf[node] : indexOf[node];
+    }
+    // Make node the first of its segment
+    void splitBefore(int node);
+    // Rebuild segments of equal size in the existing storage
+    void rebalance();
+    // Reverse the run of length segments starting at rank from (wrapping around)
+    void reverseRun(int from, int length);
+
+    int count = 0;
+    int segmentSize = 1;
+    std::vector<Segment> segments;  // ids [0, order.size()) in use, the rest spare
+    std::vector<int> order;       // segment ids in tour order
+    std::vector<int> segmentOf;   // -1 if the node is not in the tour
+    std::vector<int> indexOf;     // index in its segment's stored nodes
+    std::vector<int> scratch;     // tour order while rebalancing
+};
+
+#endif
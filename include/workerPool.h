@@ -0,0 +1,52 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+// Threads kept alive between parallel loops. run(count, job) calls
+// job(begin, end) on chunks covering 0..count-1, handed out one at a time to
+// the workers and the calling thread, and returns once all are done. Jobs are
+// passed by reference without type erasure, so a run allocates nothing.
+class WorkerPool {
+public:
+    // threads counts the calling thread: threads - 1 workers are started
+    explicit WorkerPool(int threads);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int threads() const { return workers.size() + 1; }
+
+    template <class Job>
+    void run(int count, Job& job) {
+        dispatch(count, [](void* context, int begin, int end) { (*static_cast<Job*>(context))(begin, end); }, &job);
+    }
+
+private:
+    using Trampoline = void (*)(void*, int, int);
+
+    void dispatch(int count, Trampoline trampoline, void* context);
+    // Take chunks until none is left
+    void work();
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    unsigned generation = 0;   // incremented for every run, 0 never means a run
+    int busy = 0;              // workers still in the current run
+    bool stopping = false;
+
+    Trampoline trampoline = nullptr;
+    void* context = nullptr;
+    int count = 0;
+    int chunk = 1;
+    std::atomic<int> nextBegin{0};
+};
+
+#endif
@@ -0,0 +1,154 @@
+#include "include/insertionCache.h"
+#include <climits>
+#include <algorithm>
+
+namespace {
+const std::vector<int> noCoordinates;
+}
+
+// About two nodes per cell, so a finished half-size tour has roughly one edge per cell
+InsertionCache::InsertionCache(const DistanceMatrix& distance, const std::vector<int>& costs, TourShape shape)
+    : distance(distance), costs(costs), shape(shape), tour(costs.size()), entries(costs.size()),
+      spatial(distance.hasCoordinates()),
+      grid(spatial ? distance.xs() : noCoordinates, spatial ? distance.ys() : noCoordinates,
+           std::max(1, distance.size() / 2)) {
+    changedNodes.reserve(entries.size());
+}
+
+void InsertionCache::reset(const std::vector<int>& nodes) {
+    tour.reset(nodes);
+    if (spatial) {
+        grid.clear();
+        for (int node : nodes) {
+            int to = shape == TourShape::Path ? tour.after(node) : tour.successor(node);
+            if (to != NONE) placeEdge(node, distance[node][to]);
+        }
+    }
+    for (int i = 0; i < (int)entries.size(); i++) {
+        if (!selected(i)) rescan(i);
+    }
+    changedNodes.clear();
+}
+
+void InsertionCache::rescan(int node) {
+    if (!spatial || tour.size() < GRID_MIN_TOUR) {
+        scanTour(node);
+        return;
+    }
+    Entry& entry = entries[node];
+    entry.best1 = entry.best2 = INT_MAX;
+    entry.edge1 = entry.edge2 = NONE;
+    DistanceMatrix::Row row = distance[node];
+    if (shape == TourShape::Path) {
+        offer(entry, row[tour.first()] + costs[node], FRONT);
+        offer(entry, row[tour.last()] + costs[node], tour.last());
+    }
+    // Rings of cells around the node; path edges never wrap since the last node has none
+    auto visit = [&](int from) {
+        int to = tour.successor(from);
+        offer(entry, row[from] + row[to] - grid.length(from) + costs[node], from);
+    };
+    int cellsVisited = 0;
+    for (int ring = 0; grid.visitRing(node, ring, visit, cellsVisited); ring++) {
+        // Unvisited edges have midpoints at least ring * cellSize() away
+        // (one extra unit of slack covers rounding in the cell assignment)
+        double bound = costs[node] + 2 * ring * grid.cellSize() - grid.maxLength() - 3;
+        if (entry.best2 != INT_MAX && bound > entry.best2) return;
+        if (cellsVisited > tour.size()) {
+            scanTour(node);
+            return;
+        }
+    }
+}
+
+void InsertionCache::scanTour(int node) {
+    Entry& entry = entries[node];
+    entry.best1 = entry.best2 = INT_MAX;
+    entry.edge1 = entry.edge2 = NONE;
+    // Distances are symmetric: read everything from the node's own row
+    DistanceMatrix::Row row = distance[node];
+    auto consider = [&](int value, int edge) {
+        if (value < entry.best1) {
+            entry.best2 = entry.best1;
+            entry.edge2 = entry.edge1;
+            entry.best1 = value;
+            entry.edge1 = edge;
+        } else if (value < entry.best2) {
+            entry.best2 = value;
+            entry.edge2 = edge;
+        }
+    };
+    // Positions in tour order: front (path only), the edges, back (path only)
+    if (shape == TourShape::Path) consider(row[tour.first()] + costs[node], FRONT);
+    int last = tour.last();
+    for (int from = tour.first(); ; from = tour.successor(from)) {
+        if (from == last && shape == TourShape::Path) {
+            consider(row[last] + costs[node], last);
+            break;
+        }
+        int to = tour.successor(from);
+        consider(row[from] + row[to] - distance[from][to] + costs[node], from);
+        if (from == last) break;
+    }
+}
+
+// Keep the two smallest (value, insertion position) pairs
+void InsertionCache::offer(Entry& entry, int value, int edge) const {
+    auto precedes = [&](int otherValue, int otherEdge) {
+        if (otherEdge == NONE) return true;
+        return value < otherValue || (value == otherValue && tour.before(edge, otherEdge));
+    };
+    if (precedes(entry.best1, entry.edge1)) {
+        entry.best2 = entry.best1;
+        entry.edge2 = entry.edge1;
+        entry.best1 = value;
+        entry.edge1 = edge;
+    } else if (precedes(entry.best2, entry.edge2)) {
+        entry.best2 = value;
+        entry.edge2 = edge;
+    }
+}
+
+void InsertionCache::insertAfter(int node, int after) {
+    int from = after;
+    int to;
+    if (from == FRONT) {
+        to = tour.first();
+    } else if (shape == TourShape::Path) {
+        to = tour.after(from);
+    } else {
+        to = tour.successor(from);
+    }
+    tour.insertAfter(node, after);
+
+    // Edge "from" now means (from, node) and edge "node" is (node, to); the old
+    // (from, to) is gone. A missing end contributes no distance. The new edges
+    // are priced from the rows of their endpoints (sequential in i).
+    DistanceMatrix::Row rowNode = distance[node];
+    DistanceMatrix::Row rowFrom = distance[from == FRONT ? node : from];
+    DistanceMatrix::Row rowTo = distance[to == NONE ? node : to];
+    int fromNode = from == FRONT ? 0 : rowFrom[node];
+    int nodeTo = to == NONE ? 0 : rowNode[to];
+    if (spatial) {
+        if (from != FRONT) placeEdge(from, fromNode);
+        if (to != NONE) placeEdge(node, nodeTo);
+    }
+    changedNodes.clear();
+    for (int i = 0; i < (int)entries.size(); i++) {
+        if (selected(i)) continue;
+        Entry& entry = entries[i];
+        int best1 = entry.best1, best2 = entry.best2;
+        if (entry.edge1 == from || entry.edge2 == from) {
+            rescan(i);
+        } else {
+            offer(entry, (from == FRONT ? 0 : rowFrom[i]) + rowNode[i] - fromNode + costs[i], from);
+            offer(entry, rowNode[i] + (to == NONE ? 0 : rowTo[i]) - nodeTo + costs[i], node);
+        }
+        if (entry.best1 != best1 || entry.best2 != best2) changedNodes.push_back(i);
+    }
+}
+
+void InsertionCache::placeEdge(int from, int length) {
+    int to = shape == TourShape::Path ? tour.after(from) : tour.successor(from);
+    grid.place(from, from, to, length);
+}
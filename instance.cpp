@@ -0,0 +1,347 @@
+#include "include/instance.h"
+#include "include/mappedFile.h"
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <charconv>
+#include <iostream>
+
+namespace {
+
+const char CACHE_MAGIC[8] = {'T', 'S', 'P', 'C', 'A', 'C', 'H', 'E'};
+const uint32_t CACHE_VERSION = 1;
+
+struct InstanceCacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t n;
+    uint32_t elementSize;
+    uint32_t packed;          // 1 if the matrix is stored as a packed triangle
+    uint64_t csvSize;
+    int64_t csvModified;
+    uint64_t nodesChecksum;
+    uint64_t matrixChecksum;
+};
+
+// FNV-1a, chained over several buffers
+uint64_t fnv1a(const void* data, size_t size, uint64_t hash = 14695981039346656037ULL) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t nodesChecksum(const std::vector<int>& xs, const std::vector<int>& ys, const std::vector<int>& costs) {
+    uint64_t hash = fnv1a(xs.data(), xs.size() * sizeof(int));
+    hash = fnv1a(ys.data(), ys.size() * sizeof(int), hash);
+    return fnv1a(costs.data(), costs.size() * sizeof(int), hash);
+}
+
+bool csvMetadata(const std::string& csvFilename, uint64_t& size, int64_t& modified) {
+    std::error_code ec;
+    size = std::filesystem::file_size(csvFilename, ec);
+    if (ec) return false;
+    auto time = std::filesystem::last_write_time(csvFilename, ec);
+    if (ec) return false;
+    modified = time.time_since_epoch().count();
+    return true;
+}
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+// Integer field surrounded by optional blanks; returns nullptr if there is no number
+const char* parseField(const char* p, const char* end, int& value) {
+    while (p < end && isBlank(*p)) p++;
+    auto [next, ec] = std::from_chars(p, end, value);
+    if (ec != std::errc()) return nullptr;
+    p = next;
+    while (p < end && isBlank(*p)) p++;
+    return p;
+}
+
+// Parse "x;y;cost" rows in place (LF or CRLF, blank lines ignored).
+// On a malformed row returns false with its 1-based number in errorLine.
+bool parseInstanceCsv(const char* data, size_t size, Instance& instance, size_t& errorLine) {
+    const char* p = data;
+    const char* end = data + size;
+    size_t rows = std::count(data, end, '\n') + 1;
+    instance.xs.reserve(rows);
+    instance.ys.reserve(rows);
+    instance.costs.reserve(rows);
+    
+    for (size_t line = 1; p < end; line++) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!eol) eol = end;
+        const char* lineEnd = eol;
+        if (lineEnd > p && lineEnd[-1] == '\r') lineEnd--;
+        
+        const char* q = p;
+        while (q < lineEnd && isBlank(*q)) q++;
+        if (q < lineEnd) {
+            int x, y, cost;
+            q = parseField(q, lineEnd, x);
+            if (q && q < lineEnd && *q == ';') q = parseField(q + 1, lineEnd, y); else q = nullptr;
+            if (q && q < lineEnd && *q == ';') q = parseField(q + 1, lineEnd, cost); else q = nullptr;
+            if (!q || q != lineEnd) {
+                errorLine = line;
+                return false;
+            }
+            instance.xs.push_back(x);
+            instance.ys.push_back(y);
+            instance.costs.push_back(cost);
+        }
+        p = eol + 1;
+    }
+    return true;
+}
+
+}
+
+Instance readInstanceCsv(const std::string& filename, bool computeDistances) {
+    Instance instance;
+    instance.filename = filename;
+    
+    auto file = MappedFile::open(filename);
+    if (!file) {
+        std::cerr << filename << ": cannot read file\n";
+        return instance;
+    }
+    size_t errorLine = 0;
+    if (!parseInstanceCsv(file->data(), file->size(), instance, errorLine)) {
+        std::cerr << filename << ":" << errorLine << ": expected x;y;cost\n";
+        instance.xs.clear();
+        instance.ys.clear();
+        instance.costs.clear();
+        return instance;
+    }
+    
+    if (computeDistances) {
+        instance.distance = DistanceMatrix::fromCoordinates(instance.xs, instance.ys);
+    }
+    return instance;
+}
+
+std::string instanceCacheFilename(const std::string& csvFilename) {
+    std::filesystem::path path(csvFilename);
+    path.replace_extension(".bin");
+    return path.string();
+}
+
+bool writeInstanceCache(const Instance& instance, const std::string& cacheFilename) {
+    InstanceCacheHeader header = {};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.n = instance.size();
+    header.elementSize = instance.distance.elementSize();
+    header.packed = instance.distance.storage() == DistanceStorage::Packed;
+    if (!csvMetadata(instance.filename, header.csvSize, header.csvModified)) return false;
+    header.nodesChecksum = nodesChecksum(instance.xs, instance.ys, instance.costs);
+    header.matrixChecksum = fnv1a(instance.distance.data(), instance.distance.bytes());
+    
+    // Write to a temporary file first so a concurrent reader never maps a partial cache
+    std::string tmpFilename = cacheFilename + ".tmp";
+    {
+        std::ofstream fout(tmpFilename, std::ios::binary | std::ios::trunc);
+        if (!fout) return false;
+        fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        fout.write(reinterpret_cast<const char*>(instance.xs.data()), instance.xs.size() * sizeof(int));
+        fout.write(reinterpret_cast<const char*>(instance.ys.data()), instance.ys.size() * sizeof(int));
+        fout.write(reinterpret_cast<const char*>(instance.costs.data()), instance.costs.size() * sizeof(int));
+        fout.write(static_cast<const char*>(instance.distance.data()), instance.distance.bytes());
+        if (!fout) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpFilename, cacheFilename, ec);
+    return !ec;
+}
+
+bool readInstanceCache(const std::string& cacheFilename, const std::string& csvFilename,
+                       Instance& instance, bool verifyMatrix) {
+    auto file = MappedFile::open(cacheFilename);
+    if (!file || file->size() < sizeof(InstanceCacheHeader)) return false;
+    
+    InstanceCacheHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0) return false;
+    if (header.version != CACHE_VERSION) return false;
+    if (header.elementSize != 2 && header.elementSize != 4) return false;
+    if (header.packed > 1) return false;
+    
+    // Stale if the CSV changed since the cache was written
+    uint64_t csvSize;
+    int64_t csvModified;
+    if (!csvMetadata(csvFilename, csvSize, csvModified)) return false;
+    if (csvSize != header.csvSize || csvModified != header.csvModified) return false;
+    
+    int n = header.n;
+    size_t nodesBytes = (size_t)n * sizeof(int);
+    DistanceStorage storage = header.packed ? DistanceStorage::Packed : DistanceStorage::Full;
+    size_t matrixElements = header.packed ? (size_t)n * (n + 1) / 2 : (size_t)n * n;
+    size_t matrixBytes = matrixElements * header.elementSize;
+    if (file->size() != sizeof(header) + 3 * nodesBytes + matrixBytes) return false;
+    
+    const char* nodes = file->data() + sizeof(header);
+    Instance loaded;
+    loaded.filename = csvFilename;
+    loaded.xs.resize(n);
+    loaded.ys.resize(n);
+    loaded.costs.resize(n);
+    std::memcpy(loaded.xs.data(), nodes, nodesBytes);
+    std::memcpy(loaded.ys.data(), nodes + nodesBytes, nodesBytes);
+    std::memcpy(loaded.costs.data(), nodes + 2 * nodesBytes, nodesBytes);
+    if (nodesChecksum(loaded.xs, loaded.ys, loaded.costs) != header.nodesChecksum) return false;
+    
+    const char* matrix = nodes + 3 * nodesBytes;
+    DistanceWidth width = header.elementSize == 2 ? DistanceWidth::Int16 : DistanceWidth::Int32;
+    loaded.distance = DistanceMatrix::view(n, width, storage, matrix, file);
+    loaded.distance.attachCoordinates(loaded.xs, loaded.ys);
+    
+    if (verifyMatrix) {
+        if (fnv1a(matrix, matrixBytes) != header.matrixChecksum) return false;
+    } else {
+        // Spot-check one entry per row against the coordinates (touches only n pages)
+        for (int i = 0; i < n; i++) {
+            int j = (int)(((long long)i * 7919 + 1) % n);
+            double dx = loaded.xs[i] - loaded.xs[j];
+            double dy = loaded.ys[i] - loaded.ys[j];
+            if (loaded.distance[i][j] != (int)round(sqrt(dx * dx + dy * dy))) return false;
+        }
+    }
+    
+    instance = std::move(loaded);
+    return true;
+}
+
+namespace {
+
+// Position of (x, y) along a Hilbert curve filling a 2^bits x 2^bits grid
+uint64_t hilbertIndex(uint32_t x, uint32_t y, int bits) {
+    uint32_t side = 1u << bits;
+    uint64_t d = 0;
+    for (uint32_t s = side / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) ? 1 : 0;
+        uint32_t ry = (y & s) ? 1 : 0;
+        d += (uint64_t)s * s * ((3 * rx) ^ ry);
+        // Rotate the quadrant so that the curve stays continuous
+        if (ry == 0) {
+            if (rx == 1) {
+                x = side - 1 - x;
+                y = side - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+Instance loadInstanceInCsvOrder(const std::string& filename, const InstanceOptions& options) {
+    std::string cacheFilename = instanceCacheFilename(filename);
+    DistanceMode mode = options.distanceMode;
+    Instance instance;
+    if (mode != DistanceMode::Lazy && readInstanceCache(cacheFilename, filename, instance)) {
+        DistanceStorage cached = instance.distance.storage();
+        if (mode == DistanceMode::Auto || (mode == DistanceMode::Full) == (cached == DistanceStorage::Full)) {
+            return instance;
+        }
+    }
+    instance = readInstanceCsv(filename, false);
+    if (instance.size() == 0) return instance;
+    
+    if (mode == DistanceMode::Auto) {
+        size_t n = instance.size();
+        size_t elementSize = DistanceMatrix::widthFor(instance.xs, instance.ys) == DistanceWidth::Int16 ? 2 : 4;
+        if (n * n * elementSize <= options.fullMatrixLimit) {
+            mode = DistanceMode::Full;
+        } else if (n * (n + 1) / 2 * elementSize <= options.fullMatrixLimit) {
+            mode = DistanceMode::Packed;
+        } else {
+            mode = DistanceMode::Lazy;
+        }
+    }
+    if (mode == DistanceMode::Lazy) {
+        instance.distance = DistanceMatrix::lazy(instance.xs, instance.ys, options.lazyCacheRows);
+        return instance;
+    }
+    if (mode == DistanceMode::Packed) {
+        instance.distance = DistanceMatrix::packed(instance.xs, instance.ys);
+    } else {
+        instance.distance = DistanceMatrix::fromCoordinates(instance.xs, instance.ys);
+    }
+    writeInstanceCache(instance, cacheFilename);
+    return instance;
+}
+
+}
+
+std::vector<int> Instance::toOriginalIds(const std::vector<int>& solution) const {
+    std::vector<int> result(solution.size());
+    for (size_t i = 0; i < solution.size(); i++) {
+        result[i] = originalId(solution[i]);
+    }
+    return result;
+}
+
+std::vector<int> hilbertOrder(const std::vector<int>& xs, const std::vector<int>& ys) {
+    const int BITS = 16;
+    int n = xs.size();
+    std::vector<int> order(n);
+    if (n == 0) return order;
+    
+    // Same scale on both axes so that the curve follows real distances
+    auto [minX, maxX] = std::minmax_element(xs.begin(), xs.end());
+    auto [minY, maxY] = std::minmax_element(ys.begin(), ys.end());
+    double extent = std::max({(double)*maxX - *minX, (double)*maxY - *minY, 1.0});
+    double scale = ((1 << BITS) - 1) / extent;
+    std::vector<uint64_t> keys(n);
+    for (int i = 0; i < n; i++) {
+        uint32_t x = (uint32_t)((xs[i] - (double)*minX) * scale);
+        uint32_t y = (uint32_t)((ys[i] - (double)*minY) * scale);
+        keys[i] = hilbertIndex(x, y, BITS);
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return keys[a] < keys[b]; });
+    return order;
+}
+
+void renumberNodes(Instance& instance, const std::vector<int>& order, int lazyCacheRows) {
+    int n = instance.size();
+    std::vector<int> xs(n), ys(n), costs(n), originalIds(n);
+    for (int i = 0; i < n; i++) {
+        xs[i] = instance.xs[order[i]];
+        ys[i] = instance.ys[order[i]];
+        costs[i] = instance.costs[order[i]];
+        originalIds[i] = instance.originalId(order[i]);
+    }
+    instance.xs = std::move(xs);
+    instance.ys = std::move(ys);
+    instance.costs = std::move(costs);
+    instance.originalIds = std::move(originalIds);
+    
+    DistanceWidth width = instance.distance.width();
+    switch (instance.distance.storage()) {
+    case DistanceStorage::Full:
+        instance.distance = DistanceMatrix::fromCoordinates(instance.xs, instance.ys, width);
+        break;
+    case DistanceStorage::Packed:
+        instance.distance = DistanceMatrix::packed(instance.xs, instance.ys, width);
+        break;
+    case DistanceStorage::Lazy:
+        instance.distance = DistanceMatrix::lazy(instance.xs, instance.ys, lazyCacheRows);
+        break;
+    }
+}
+
+Instance loadInstance(const std::string& filename, const InstanceOptions& options) {
+    Instance instance = loadInstanceInCsvOrder(filename, options);
+    if (options.hilbertOrder && instance.size() > 0) {
+        renumberNodes(instance, hilbertOrder(instance.xs, instance.ys), options.lazyCacheRows);
+    }
+    return instance;
+}
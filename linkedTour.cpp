@@ -0,0 +1,73 @@
+#include "include/linkedTour.h"
+
+LinkedTour::LinkedTour(int n) : next(n, NONE), prev(n, NONE), label(n, 0) {}
+
+void LinkedTour::reset(const std::vector<int>& nodes) {
+    for (int node = head; node != NONE; ) {
+        int following = node == tail ? NONE : next[node];
+        next[node] = prev[node] = NONE;
+        node = following;
+    }
+    head = tail = NONE;
+    count = 0;
+    for (int node : nodes) insertAfter(node, count == 0 ? FRONT : tail);
+}
+
+void LinkedTour::insertAfter(int node, int afterNode) {
+    if (count == 0) {
+        head = tail = node;
+        next[node] = prev[node] = node;   // not NONE, so contains() holds
+        label[node] = 0;
+        count = 1;
+        return;
+    }
+    if (afterNode == FRONT) {
+        next[node] = head;
+        prev[node] = node;
+        prev[head] = node;
+        label[node] = label[head] - GAP;
+        head = node;
+    } else if (afterNode == tail) {
+        next[tail] = node;
+        prev[node] = tail;
+        next[node] = node;
+        label[node] = label[tail] + GAP;
+        tail = node;
+    } else {
+        int following = next[afterNode];
+        next[afterNode] = node;
+        prev[node] = afterNode;
+        next[node] = following;
+        prev[following] = node;
+        if (label[following] - label[afterNode] < 2) {
+            relabel();
+        } else {
+            label[node] = label[afterNode] + (label[following] - label[afterNode]) / 2;
+        }
+    }
+    count++;
+}
+
+void LinkedTour::relabel() {
+    long long value = 0;
+    for (int node = head; ; node = next[node]) {
+        label[node] = value;
+        value += GAP;
+        if (node == tail) break;
+    }
+}
+
+std::vector<int> LinkedTour::toVector() const {
+    std::vector<int> result;
+    result.reserve(count);
+    toVector(result);
+    return result;
+}
+
+void LinkedTour::toVector(std::vector<int>& nodes) const {
+    nodes.clear();
+    for (int node = head; count > 0; node = next[node]) {
+        nodes.push_back(node);
+        if (node == tail) break;
+    }
+}
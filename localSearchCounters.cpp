@@ -0,0 +1,31 @@
+#include "include/localSearchCounters.h"
+
+namespace lsCountersDetail {
+
+Totals totals;
+
+}
+
+LSCounters lsCountersSnapshot() {
+    using lsCountersDetail::totals;
+    LSCounters counters;
+    counters.deltaEvaluations = totals.deltaEvaluations.load(std::memory_order_relaxed);
+    counters.improvingMoves = totals.improvingMoves.load(std::memory_order_relaxed);
+    counters.intraApplied = totals.intraApplied.load(std::memory_order_relaxed);
+    counters.exchangeApplied = totals.exchangeApplied.load(std::memory_order_relaxed);
+    counters.candidateChecks = totals.candidateChecks.load(std::memory_order_relaxed);
+    counters.staleDiscarded = totals.staleDiscarded.load(std::memory_order_relaxed);
+    counters.listHighWater = totals.listHighWater.load(std::memory_order_relaxed);
+    return counters;
+}
+
+void lsCountersReset() {
+    using lsCountersDetail::totals;
+    totals.deltaEvaluations = 0;
+    totals.improvingMoves = 0;
+    totals.intraApplied = 0;
+    totals.exchangeApplied = 0;
+    totals.candidateChecks = 0;
+    totals.staleDiscarded = 0;
+    totals.listHighWater = 0;
+}
@@ -0,0 +1,32 @@
+#include "include/localSearchWorkspace.h"
+
+LSWorkspace::LSWorkspace(int n) {
+    solution.reserve(n);
+    inSolution.reserve(n);
+    position.reserve(n);
+    positions.reserve(n);
+    rowValue.reserve(2 * n);
+    intraColumn.reserve(n);
+    interNode.reserve(n);
+    dirty.reserve(n);
+    nonSelected.reserve(n);
+    tour.reserve(n);
+    // The don't-look-bits queue is compacted once more than n nodes were taken
+    // from it and they are over half of it
+    queue.reserve(2 * n + 4);
+    queued.reserve(n);
+}
+
+void LSWorkspace::start(const std::vector<int>& initialSolution, int n) {
+    if (&initialSolution != &solution) solution = initialSolution;
+    inSolution.assign(n, false);
+    for (int node : solution) inSolution[node] = true;
+}
+
+void LSWorkspace::setThreads(int threads) {
+    if (threads <= 1) {
+        pool.reset();
+    } else if (!pool || pool->threads() != threads) {
+        pool = std::make_unique<WorkerPool>(threads);
+    }
+}
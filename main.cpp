@@ -12,6 +12,8 @@
 #include <ctime>
 #include <iomanip>
 #include "include/constants.h"
+#include "include/distanceMatrix.h"
+#include "include/instance.h"
 #include "include/calculateObjective.h"
 #include "include/randomSolution.h"
 #include "include/nearestNeighborEnd.h"
@@ -19,6 +21,7 @@
 #include "include/greedyCycle.h"
 #include "include/greedyRegret2.h"
 #include "include/greedyRegret2Weighted.h"
+#include "include/greedyRegretK.h"
 #include "include/nearestNeighborAnyRegret2.h"
 #include "include/nearestNeighborAnyRegret2Weighted.h"
 #include "include/algorithmEvaluator.h"
@@ -29,39 +32,13 @@
 #include "include/largeNeighborhoodSearch.h"
 #include "include/globalConvexity.h"
 
-std::vector<int> process(const std::string& filename, bool returnBestSolution = false) {
-    std::vector<std::tuple<int, int, int>> table;
-    
-    // Read file
-    std::ifstream fin(filename);
-    std::string line;
-    while (std::getline(fin, line)) {
-        if (line.empty()) continue;
-        std::replace(line.begin(), line.end(), ';', ' ');
-        std::istringstream iss(line);
-        int x, y, cost;
-        if (iss >> x >> y >> cost) {
-            table.push_back(std::make_tuple(x, y, cost));
-        }
-    }
-    fin.close();
-    
-    // Calculate distance matrix and costs
-    int n = table.size();
+std::vector<int> process(const Instance& instance, bool returnBestSolution = false) {
+    const std::string& filename = instance.filename;
+    const DistanceMatrix& distance = instance.distance;
+    const std::vector<int>& costs = instance.costs;
+    int n = instance.size();
     int selectCount = (n + 1) / 2;
     
-    std::vector<std::vector<int>> distance(n, std::vector<int>(n));
-    std::vector<int> costs(n);
-    
-    for (int i = 0; i < n; i++) {
-        costs[i] = std::get<2>(table[i]);
-        for (int j = 0; j < n; j++) {
-            double dx = std::get<0>(table[i]) - std::get<0>(table[j]);
-            double dy = std::get<1>(table[i]) - std::get<1>(table[j]);
-            distance[i][j] = round(sqrt(dx * dx + dy * dy));
-        }
-    }
-    
     std::cout << "\n=-=-= " << filename << " =-=-=\n";
     std::cout << "Nodes: " << n << ", Selecting: " << selectCount << "\n\n";
     
@@ -76,46 +53,59 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
         randomInitials[start] = randomSolution(start, n, selectCount, rng);
     }
 
+    // Neighbours of every node ranked by distance + cost, shared by the constructors. Its
+    // build is reported on its own line: the per-start times below do not include it.
+    auto rankingBegin = std::chrono::high_resolution_clock::now();
+    NeighborRanking ranking(distance, costs);
+    auto rankingEnd = std::chrono::high_resolution_clock::now();
+    double rankingMs = std::chrono::duration<double, std::milli>(rankingEnd - rankingBegin).count();
+    std::cout << "Neighbor Ranking (shared setup):\n";
+    std::cout << "  Time (ms): Total=" << rankingMs << ", Per start=" << rankingMs / n << "\n\n";
+
     // Random solutions
     auto resultRandom = evaluateAlgorithm("Random", n, selectCount, distance, costs,
         [&](int start) { return randomInitials[start]; });
-    printAlgorithmResult("Random", resultRandom);
+    printAlgorithmResult("Random", resultRandom, instance.originalIds);
     
     // Nearest neighbor (end only)
-    auto resultNNEnd = evaluateAlgorithm("Nearest Neighbor (end only)", n, selectCount, distance, costs,
-        [&](int start) { return nearestNeighborEnd(start, selectCount, distance, costs); });
-    printAlgorithmResult("Nearest Neighbor (end only)", resultNNEnd);
+    auto resultNNEnd = evaluateBatch(nearestNeighborEndBatch(allStarts(n), selectCount, distance, costs, ranking),
+                                     distance, costs);
+    printAlgorithmResult("Nearest Neighbor (end only)", resultNNEnd, instance.originalIds);
     
     // Nearest neighbor (any position)
     auto resultNNAny = evaluateAlgorithm("Nearest Neighbor (any position)", n, selectCount, distance, costs,
         [&](int start) { return nearestNeighborAny(start, selectCount, distance, costs); });
-    printAlgorithmResult("Nearest Neighbor (any position)", resultNNAny);
+    printAlgorithmResult("Nearest Neighbor (any position)", resultNNAny, instance.originalIds);
     
     // Greedy cycle
-    auto resultGC = evaluateAlgorithm("Greedy Cycle", n, selectCount, distance, costs,
-        [&](int start) { return greedyCycle(start, selectCount, distance, costs); });
-    printAlgorithmResult("Greedy Cycle", resultGC);
+    auto resultGC = evaluateBatch(greedyCycleBatch(allStarts(n), selectCount, distance, costs), distance, costs);
+    printAlgorithmResult("Greedy Cycle", resultGC, instance.originalIds);
 
     // Greedy 2-regret
     auto resultGR2 = evaluateAlgorithm("Greedy 2-Regret", n, selectCount, distance, costs,
-        [&](int start) { return greedyRegret2(start, selectCount, distance, costs); });
-    printAlgorithmResult("Greedy 2-Regret", resultGR2);
+        [&](int start) { return greedyRegret2(start, selectCount, distance, costs, &ranking); });
+    printAlgorithmResult("Greedy 2-Regret", resultGR2, instance.originalIds);
 
     // Greedy weighted (2-regret + best delta)
     double wRegret = 1.0, wBest = 1.0;
     auto resultGW = evaluateAlgorithm("Greedy Weighted (2-Regret + BestDelta)", n, selectCount, distance, costs,
-        [&](int start) { return greedyRegret2Weighted(start, selectCount, distance, costs, wRegret, wBest); });
-    printAlgorithmResult("Greedy Weighted (2-Regret + BestDelta)", resultGW);
+        [&](int start) { return greedyRegret2Weighted(start, selectCount, distance, costs, wRegret, wBest, &ranking); });
+    printAlgorithmResult("Greedy Weighted (2-Regret + BestDelta)", resultGW, instance.originalIds);
+
+    // Greedy weighted 3-regret (sum of the two next-best insertions)
+    auto resultGW3 = evaluateAlgorithm("Greedy Weighted (3-Regret + BestDelta)", n, selectCount, distance, costs,
+        [&](int start) { return greedyRegretK(start, selectCount, distance, costs, 3, wRegret, wBest); });
+    printAlgorithmResult("Greedy Weighted (3-Regret + BestDelta)", resultGW3, instance.originalIds);
 
     // Nearest Neighbor Any 2-Regret
     auto resultNNAR2 = evaluateAlgorithm("Nearest Neighbor Any 2-Regret", n, selectCount, distance, costs,
         [&](int start) { return nearestNeighborAnyRegret2(start, selectCount, distance, costs); });
-    printAlgorithmResult("Nearest Neighbor Any 2-Regret", resultNNAR2);
+    printAlgorithmResult("Nearest Neighbor Any 2-Regret", resultNNAR2, instance.originalIds);
 
     // Nearest Neighbor Any Weighted (2-regret + best delta)
     auto resultNNAW = evaluateAlgorithm("Nearest Neighbor Any Weighted (2-Regret + BestDelta)", n, selectCount, distance, costs,
         [&](int start) { return nearestNeighborAnyRegret2Weighted(start, selectCount, distance, costs, wRegret, wBest); });
-    printAlgorithmResult("Nearest Neighbor Any Weighted (2-Regret + BestDelta)", resultNNAW);
+    printAlgorithmResult("Nearest Neighbor Any Weighted (2-Regret + BestDelta)", resultNNAW, instance.originalIds);
     
     // Find best greedy heuristic for starting solutions
     int bestGreedyObj = std::min({resultNNAny.avgObj, resultGC.avgObj, resultGR2.avgObj, resultGW.avgObj, resultNNAR2.avgObj, resultNNAW.avgObj});
@@ -123,13 +113,13 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
     if (bestGreedyObj == resultNNAny.avgObj) {
         bestGreedyFunc = [&](int start) { return nearestNeighborAny(start, selectCount, distance, costs); };
     } else if (bestGreedyObj == resultGW.avgObj) {
-        bestGreedyFunc = [&](int start) { return greedyRegret2Weighted(start, selectCount, distance, costs, wRegret, wBest); };
+        bestGreedyFunc = [&](int start) { return greedyRegret2Weighted(start, selectCount, distance, costs, wRegret, wBest, &ranking); };
     } else if (bestGreedyObj == resultNNAW.avgObj) {
         bestGreedyFunc = [&](int start) { return nearestNeighborAnyRegret2Weighted(start, selectCount, distance, costs, wRegret, wBest); };
     } else if (bestGreedyObj == resultGC.avgObj) {
-        bestGreedyFunc = [&](int start) { return greedyCycle(start, selectCount, distance, costs); };
+        bestGreedyFunc = [&](int start) { return greedyCycle(start, selectCount, distance, costs, &ranking); };
     } else if (bestGreedyObj == resultGR2.avgObj) {
-        bestGreedyFunc = [&](int start) { return greedyRegret2(start, selectCount, distance, costs); };
+        bestGreedyFunc = [&](int start) { return greedyRegret2(start, selectCount, distance, costs, &ranking); };
     } else {
         bestGreedyFunc = [&](int start) { return nearestNeighborAnyRegret2(start, selectCount, distance, costs); };
     }
@@ -140,7 +130,7 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
             auto initial = randomInitials[start];
             return localSearchSteepestNodes(initial, distance, costs, n);
         });
-    printAlgorithmResult("LS Random + Steepest + Nodes", resultLSRandomSteepestNodes);
+    printAlgorithmResult("LS Random + Steepest + Nodes", resultLSRandomSteepestNodes, instance.originalIds);
     
     // Local Search: Random start + Greedy + Nodes
     auto resultLSRandomGreedyNodes = evaluateAlgorithm("LS Random + Greedy + Nodes", n, selectCount, distance, costs,
@@ -148,7 +138,7 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
             auto initial = randomInitials[start];
             return localSearchGreedyNodes(initial, distance, costs, n, rng);
         });
-    printAlgorithmResult("LS Random + Greedy + Nodes", resultLSRandomGreedyNodes);
+    printAlgorithmResult("LS Random + Greedy + Nodes", resultLSRandomGreedyNodes, instance.originalIds);
     
     // Local Search: Random start + Greedy + Edges
     auto resultLSRandomGreedyEdges = evaluateAlgorithm("LS Random + Greedy + Edges", n, selectCount, distance, costs,
@@ -156,7 +146,7 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
             auto initial = randomInitials[start];
             return localSearchGreedyEdges(initial, distance, costs, n, rng);
         });
-    printAlgorithmResult("LS Random + Greedy + Edges", resultLSRandomGreedyEdges);
+    printAlgorithmResult("LS Random + Greedy + Edges", resultLSRandomGreedyEdges, instance.originalIds);
     
     // Local Search: Greedy start + Steepest + Nodes
     auto resultLSGreedySteepestNodes = evaluateAlgorithm("LS Greedy + Steepest + Nodes", n, selectCount, distance, costs,
@@ -164,7 +154,7 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
             auto initial = bestGreedyFunc(start);
             return localSearchSteepestNodes(initial, distance, costs, n);
         });
-    printAlgorithmResult("LS Greedy + Steepest + Nodes", resultLSGreedySteepestNodes);
+    printAlgorithmResult("LS Greedy + Steepest + Nodes", resultLSGreedySteepestNodes, instance.originalIds);
     
     // Local Search: Greedy start + Steepest + Edges
     auto resultLSGreedySteepestEdges = evaluateAlgorithm("LS Greedy + Steepest + Edges", n, selectCount, distance, costs,
@@ -172,7 +162,7 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
             auto initial = bestGreedyFunc(start);
             return localSearchSteepestEdges(initial, distance, costs, n);
         });
-    printAlgorithmResult("LS Greedy + Steepest + Edges", resultLSGreedySteepestEdges);
+    printAlgorithmResult("LS Greedy + Steepest + Edges", resultLSGreedySteepestEdges, instance.originalIds);
     
     // Local Search: Greedy start + Greedy + Nodes
     auto resultLSGreedyGreedyNodes = evaluateAlgorithm("LS Greedy + Greedy + Nodes", n, selectCount, distance, costs,
@@ -180,7 +170,7 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
             auto initial = bestGreedyFunc(start);
             return localSearchGreedyNodes(initial, distance, costs, n, rng);
         });
-    printAlgorithmResult("LS Greedy + Greedy + Nodes", resultLSGreedyGreedyNodes);
+    printAlgorithmResult("LS Greedy + Greedy + Nodes", resultLSGreedyGreedyNodes, instance.originalIds);
     
     // Local Search: Greedy start + Greedy + Edges
     auto resultLSGreedyGreedyEdges = evaluateAlgorithm("LS Greedy + Greedy + Edges", n, selectCount, distance, costs,
@@ -188,7 +178,7 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
             auto initial = bestGreedyFunc(start);
             return localSearchGreedyEdges(initial, distance, costs, n, rng);
         });
-    printAlgorithmResult("LS Greedy + Greedy + Edges", resultLSGreedyGreedyEdges);
+    printAlgorithmResult("LS Greedy + Greedy + Edges", resultLSGreedyGreedyEdges, instance.originalIds);
     
     // Local Search: Random start + Steepest + Edges
     auto resultLSRandomSteepestEdges = evaluateAlgorithm("LS Random + Steepest + Edges", n, selectCount, distance, costs,
@@ -196,7 +186,7 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
             auto initial = randomInitials[start];
             return localSearchSteepestEdges(initial, distance, costs, n);
         });
-    printAlgorithmResult("LS Random + Steepest + Edges", resultLSRandomSteepestEdges);
+    printAlgorithmResult("LS Random + Steepest + Edges", resultLSRandomSteepestEdges, instance.originalIds);
     
     // Local Search: Random start + Steepest + Edges with LM (list of improving moves)
     auto resultLSRandomSteepestEdgesLM = evaluateAlgorithm("LM Random + Steepest + Edges", n, selectCount, distance, costs,
@@ -204,7 +194,7 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
             auto initial = randomInitials[start];
             return localSearchSteepestEdgesLM(initial, distance, costs, n);
         });
-    printAlgorithmResult("LM Random + Steepest + Edges", resultLSRandomSteepestEdgesLM);
+    printAlgorithmResult("LM Random + Steepest + Edges", resultLSRandomSteepestEdgesLM, instance.originalIds);
         
     // Candidate Moves with different k values
     auto resultCandidatesK5 = evaluateAlgorithm("Candidates + Random + Steepest + Edges (k=5)", n, selectCount, distance, costs,
@@ -212,28 +202,28 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
             auto initial = randomInitials[start];
             return localSearchSteepestEdgesCandidates(initial, distance, costs, n, 5);
         });
-    printAlgorithmResult("Candidates + Random + Steepest + Edges (k=5)", resultCandidatesK5);
+    printAlgorithmResult("Candidates + Random + Steepest + Edges (k=5)", resultCandidatesK5, instance.originalIds);
     
     auto resultCandidatesK10 = evaluateAlgorithm("Candidates + Random + Steepest + Edges (k=10)", n, selectCount, distance, costs,
         [&](int start) { 
             auto initial = randomInitials[start];
             return localSearchSteepestEdgesCandidates(initial, distance, costs, n, 10);
         });
-    printAlgorithmResult("Candidates + Random + Steepest + Edges (k=10)", resultCandidatesK10);
+    printAlgorithmResult("Candidates + Random + Steepest + Edges (k=10)", resultCandidatesK10, instance.originalIds);
     
     auto resultCandidatesK15 = evaluateAlgorithm("Candidates + Random + Steepest + Edges (k=15)", n, selectCount, distance, costs,
         [&](int start) { 
             auto initial = randomInitials[start];
             return localSearchSteepestEdgesCandidates(initial, distance, costs, n, 15);
         });
-    printAlgorithmResult("Candidates + Random + Steepest + Edges (k=15)", resultCandidatesK15);
+    printAlgorithmResult("Candidates + Random + Steepest + Edges (k=15)", resultCandidatesK15, instance.originalIds);
     
     auto resultCandidatesK20 = evaluateAlgorithm("Candidates + Random + Steepest + Edges (k=20)", n, selectCount, distance, costs,
         [&](int start) { 
             auto initial = randomInitials[start];
             return localSearchSteepestEdgesCandidates(initial, distance, costs, n, 20);
         });
-    printAlgorithmResult("Candidates + Random + Steepest + Edges (k=20)", resultCandidatesK20);
+    printAlgorithmResult("Candidates + Random + Steepest + Edges (k=20)", resultCandidatesK20, instance.originalIds);
 
     // LM + Candidate Moves (k=10)
     auto resultLMCandidatesK10 = evaluateAlgorithm("LM Candidates + Random + Steepest + Edges (k=10)", n, selectCount, distance, costs,
@@ -241,7 +231,7 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
             auto initial = randomInitials[start];
             return localSearchSteepestEdgesLMCandidates(initial, distance, costs, n, 10);
         });
-    printAlgorithmResult("LM Candidates + Random + Steepest + Edges (k=10)", resultLMCandidatesK10);
+    printAlgorithmResult("LM Candidates + Random + Steepest + Edges (k=10)", resultLMCandidatesK10, instance.originalIds);
 
     // LM + Candidate Moves (k=20)
     auto resultLMCandidatesK20 = evaluateAlgorithm("LM Candidates + Random + Steepest + Edges (k=20)", n, selectCount, distance, costs,
@@ -249,7 +239,7 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
             auto initial = randomInitials[start];
             return localSearchSteepestEdgesLMCandidates(initial, distance, costs, n, 100);
         });
-    printAlgorithmResult("LM Candidates + Random + Steepest + Edges (k=20)", resultLMCandidatesK20);
+    printAlgorithmResult("LM Candidates + Random + Steepest + Edges (k=20)", resultLMCandidatesK20, instance.originalIds);
     
     // Multiple Start Local Search - run 20 times
     // We use a custom evaluator for this specifically because it has to run exactly 20 times.
@@ -264,7 +254,7 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
             }
             return multipleStartLS(n, selectCount, distance, costs, randomInitials, mslsIterations, rng); }
     );
-    printAlgorithmResult("Multiple Start Local Search (200 iterations)", mslsResult);
+    printAlgorithmResult("Multiple Start Local Search (200 iterations)", mslsResult, instance.originalIds);
     
     // Iterated Local Search - run 20 times with time limit = average MSLS time
     double ilsTimeLimit = mslsResult.avgTime;
@@ -293,7 +283,7 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
     }
     double avgLSRuns = sumLSRuns / 20.0;
     
-    printAlgorithmResult("Iterated Local Search (time limit = " + std::to_string((int)ilsTimeLimit) + " ms)", ilsResult);
+    printAlgorithmResult("Iterated Local Search (time limit = " + std::to_string((int)ilsTimeLimit) + " ms)", ilsResult, instance.originalIds);
     std::cout << "  LS Runs: Avg=" << avgLSRuns << "\n\n" << std::flush;
     
     // Large Neighborhood Search with Local Search - run 20 times with time limit = average MSLS time
@@ -320,7 +310,7 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
     }
     double avgLNSWithLSIter = sumLNSWithLSIter / 20.0;
     
-    printAlgorithmResult("LNS with LS (time limit = " + std::to_string((int)lnsTimeLimit) + " ms)", lnsWithLSResult);
+    printAlgorithmResult("LNS with LS (time limit = " + std::to_string((int)lnsTimeLimit) + " ms)", lnsWithLSResult, instance.originalIds);
     std::cout << "  Iterations: Avg=" << avgLNSWithLSIter << "\n\n" << std::flush;
     
     // Large Neighborhood Search without Local Search - run 20 times with time limit = average MSLS time
@@ -346,13 +336,42 @@ std::vector<int> process(const std::string& filename, bool returnBestSolution =
     }
     double avgLNSNoLSIter = sumLNSNoLSIter / 20.0;
     
-    printAlgorithmResult("LNS without LS (time limit = " + std::to_string((int)lnsTimeLimit) + " ms)", lnsNoLSResult);
+    printAlgorithmResult("LNS without LS (time limit = " + std::to_string((int)lnsTimeLimit) + " ms)", lnsNoLSResult, instance.originalIds);
     std::cout << "  Iterations: Avg=" << avgLNSNoLSIter << "\n\n" << std::flush;
     
     return bestILSSolution;
 }
 
-int main() {
+// Options: --distances=auto|full|packed|lazy, --cache-rows=N (rows kept by the lazy distance cache),
+// --order=csv|hilbert (node numbering; solutions are always printed with CSV row numbers)
+InstanceOptions parseInstanceOptions(int argc, char* argv[]) {
+    InstanceOptions options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--distances=auto") {
+            options.distanceMode = DistanceMode::Auto;
+        } else if (arg == "--distances=full") {
+            options.distanceMode = DistanceMode::Full;
+        } else if (arg == "--distances=packed") {
+            options.distanceMode = DistanceMode::Packed;
+        } else if (arg == "--distances=lazy") {
+            options.distanceMode = DistanceMode::Lazy;
+        } else if (arg.rfind("--cache-rows=", 0) == 0) {
+            options.lazyCacheRows = std::stoi(arg.substr(13));
+        } else if (arg == "--order=csv") {
+            options.hilbertOrder = false;
+        } else if (arg == "--order=hilbert") {
+            options.hilbertOrder = true;
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+        }
+    }
+    return options;
+}
+
+int main(int argc, char* argv[]) {
+    InstanceOptions instanceOptions = parseInstanceOptions(argc, argv);
+    
     // std::ios_base::sync_with_stdio(false);
     // std::cin.tie(0);
     // std::cout.tie(0);
@@ -362,44 +381,24 @@ int main() {
     auto startTimeT = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
     std::cout << "Execution started at: " << std::put_time(std::localtime(&startTimeT), "%Y-%m-%d %H:%M:%S") << "\n\n" << std::flush;
     
-    std::vector<int> bestSolutionA = process("input/TSPA.csv", true);
-    std::vector<int> bestSolutionB = process("input/TSPB.csv", true);
+    // Instances are loaded once (through the binary cache) and shared by all assignments
+    Instance instanceA = loadInstance("input/TSPA.csv", instanceOptions);
+    Instance instanceB = loadInstance("input/TSPB.csv", instanceOptions);
+    if (instanceA.size() == 0 || instanceB.size() == 0) return 1;
+    
+    std::vector<int> bestSolutionA = process(instanceA, true);
+    std::vector<int> bestSolutionB = process(instanceB, true);
     
     // Assignment 8: Global Convexity Tests
     std::cout << "\n" << std::flush;
     
-    // We need to re-read the instances to run global convexity analysis
     std::mt19937 rngGC(DEFAULT_SEED);
     
     // TSPA
     {
-        std::vector<std::tuple<int, int, int>> table;
-        std::ifstream fin("input/TSPA.csv");
-        std::string line;
-        while (std::getline(fin, line)) {
-            if (line.empty()) continue;
-            std::replace(line.begin(), line.end(), ';', ' ');
-            std::istringstream iss(line);
-            int x, y, cost;
-            if (iss >> x >> y >> cost) {
-                table.push_back(std::make_tuple(x, y, cost));
-            }
-        }
-        fin.close();
-        
-        int n = table.size();
-        std::vector<std::vector<int>> distance(n, std::vector<int>(n));
-        std::vector<int> costs(n);
-        
-        for (int i = 0; i < n; i++) {
-            costs[i] = std::get<2>(table[i]);
-            for (int j = 0; j < n; j++) {
-                double dx = std::get<0>(table[i]) - std::get<0>(table[j]);
-                double dy = std::get<1>(table[i]) - std::get<1>(table[j]);
-                distance[i][j] = round(sqrt(dx * dx + dy * dy));
-            }
-        }
-        
+        const DistanceMatrix& distance = instanceA.distance;
+        const std::vector<int>& costs = instanceA.costs;
+        int n = instanceA.size();
         int selectCount = (n + 1) / 2;
         auto resultA = analyzeGlobalConvexity("TSPA", n, selectCount, distance, costs, bestSolutionA, rngGC);
         exportConvexityData(resultA, "output");
@@ -411,7 +410,7 @@ int main() {
         std::cout << "  Time (ms): Min=" << resultA.totalTime << ", Max=" << resultA.totalTime 
                   << ", Avg=" << resultA.totalTime << "\n";
         std::cout << "  Best:";
-        for (int node : resultA.bestSolution) {
+        for (int node : instanceA.toOriginalIds(resultA.bestSolution)) {
             std::cout << " " << node;
         }
         std::cout << "\n";
@@ -445,33 +444,9 @@ int main() {
     
     // TSPB
     {
-        std::vector<std::tuple<int, int, int>> table;
-        std::ifstream fin("input/TSPB.csv");
-        std::string line;
-        while (std::getline(fin, line)) {
-            if (line.empty()) continue;
-            std::replace(line.begin(), line.end(), ';', ' ');
-            std::istringstream iss(line);
-            int x, y, cost;
-            if (iss >> x >> y >> cost) {
-                table.push_back(std::make_tuple(x, y, cost));
-            }
-        }
-        fin.close();
-        
-        int n = table.size();
-        std::vector<std::vector<int>> distance(n, std::vector<int>(n));
-        std::vector<int> costs(n);
-        
-        for (int i = 0; i < n; i++) {
-            costs[i] = std::get<2>(table[i]);
-            for (int j = 0; j < n; j++) {
-                double dx = std::get<0>(table[i]) - std::get<0>(table[j]);
-                double dy = std::get<1>(table[i]) - std::get<1>(table[j]);
-                distance[i][j] = round(sqrt(dx * dx + dy * dy));
-            }
-        }
-        
+        const DistanceMatrix& distance = instanceB.distance;
+        const std::vector<int>& costs = instanceB.costs;
+        int n = instanceB.size();
         int selectCount = (n + 1) / 2;
         auto resultB = analyzeGlobalConvexity("TSPB", n, selectCount, distance, costs, bestSolutionB, rngGC);
         exportConvexityData(resultB, "output");
@@ -483,7 +458,7 @@ int main() {
         std::cout << "  Time (ms): Min=" << resultB.totalTime << ", Max=" << resultB.totalTime 
                   << ", Avg=" << resultB.totalTime << "\n";
         std::cout << "  Best:";
-        for (int node : resultB.bestSolution) {
+        for (int node : instanceB.toOriginalIds(resultB.bestSolution)) {
             std::cout << " " << node;
         }
         std::cout << "\n";
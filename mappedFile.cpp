@@ -0,0 +1,53 @@
+#include "include/mappedFile.h"
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define HAVE_MMAP 1
+#endif
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string& filename) {
+    std::shared_ptr<MappedFile> file(new MappedFile());
+#ifdef HAVE_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return nullptr;
+    }
+    void* address = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) return nullptr;
+    file->begin = static_cast<const char*>(address);
+    file->length = st.st_size;
+    file->mapped = true;
+#else
+    std::ifstream fin(filename, std::ios::binary | std::ios::ate);
+    if (!fin) return nullptr;
+    std::streamsize size = fin.tellg();
+    if (size <= 0) return nullptr;
+    char* buffer = new char[size];
+    fin.seekg(0);
+    if (!fin.read(buffer, size)) {
+        delete[] buffer;
+        return nullptr;
+    }
+    file->begin = buffer;
+    file->length = size;
+#endif
+    return file;
+}
+
+MappedFile::~MappedFile() {
+#ifdef HAVE_MMAP
+    if (mapped) {
+        munmap(const_cast<char*>(begin), length);
+        return;
+    }
+#endif
+    delete[] begin;
+}
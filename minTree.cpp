@@ -0,0 +1,22 @@
+#include "include/minTree.h"
+#include <climits>
+
+MinTree::MinTree(int leaves) {
+    reset(leaves);
+}
+
+void MinTree::reset(int leaves) {
+    width = 1;
+    while (width < leaves) width *= 2;
+    values.assign(width, INT_MAX);
+    winner.assign(2 * width, 0);
+    for (int i = 0; i < width; i++) winner[width + i] = i;
+    for (int node = width - 1; node >= 1; node--) winner[node] = better(winner[2 * node], winner[2 * node + 1]);
+}
+
+void MinTree::set(int leaf, int value) {
+    values[leaf] = value;
+    for (int node = (width + leaf) / 2; node >= 1; node /= 2) {
+        winner[node] = better(winner[2 * node], winner[2 * node + 1]);
+    }
+}
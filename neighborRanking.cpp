@@ -0,0 +1,21 @@
+#include "include/neighborRanking.h"
+#include <algorithm>
+#include <numeric>
+
+NeighborRanking::NeighborRanking(const DistanceMatrix& distance, const std::vector<int>& costs, int width) {
+    int n = distance.size();
+    rowWidth = std::max(0, std::min(width, n - 1));
+    order.resize((size_t)n * rowWidth);
+    std::vector<int> nodes(n);
+    std::vector<int> key(n);
+    for (int u = 0; u < n; u++) {
+        DistanceMatrix::Row row = distance[u];
+        for (int v = 0; v < n; v++) key[v] = row[v] + costs[v];
+        std::iota(nodes.begin(), nodes.end(), 0);
+        // u itself is never a candidate: move it to the end before ranking
+        std::swap(nodes[u], nodes[n - 1]);
+        auto less = [&](int a, int b) { return key[a] < key[b] || (key[a] == key[b] && a < b); };
+        std::partial_sort(nodes.begin(), nodes.begin() + rowWidth, nodes.end() - 1, less);
+        std::copy(nodes.begin(), nodes.begin() + rowWidth, order.begin() + (size_t)u * rowWidth);
+    }
+}
@@ -0,0 +1,95 @@
+#include "include/randomMoveOrder.h"
+#include <algorithm>
+
+void RandomMoveOrder::restart(long long newCount) {
+    count = newCount;
+    taken = 0;
+    used = 0;
+    dense = count <= DENSE_LIMIT;
+    if (dense && (long long)stamp.size() < count) {
+        swapped.resize(count);
+        stamp.resize(count, 0);
+    }
+    if (++round == 0) {
+        // Stamps wrapped around: clear them so that nothing looks current
+        std::fill(stamp.begin(), stamp.end(), 0);
+        for (Entry& entry : table) entry.round = 0;
+        round = 1;
+    }
+}
+
+long long RandomMoveOrder::next(std::mt19937& rng) {
+    // Swap a random remaining slot into position taken and return it
+    long long pick = std::uniform_int_distribution<long long>(taken, count - 1)(rng);
+    if (dense) {
+        int value = slot((int)pick);
+        if (pick != taken) {
+            swapped[pick] = slot((int)taken);
+            stamp[pick] = round;
+        }
+        taken++;
+        return value;
+    }
+
+    // Position taken is never read again, so its entry is dropped
+    long long atTaken = taken;
+    size_t index = find(taken);
+    if (index < table.size()) {
+        atTaken = table[index].value;
+        erase(index);
+    }
+    taken++;
+    if (pick == taken - 1) return atTaken;
+    return exchange(pick, atTaken);
+}
+
+size_t RandomMoveOrder::find(long long slot) const {
+    if (used == 0) return table.size();
+    size_t mask = table.size() - 1;
+    for (size_t index = home(slot); current(index); index = (index + 1) & mask) {
+        if (table[index].slot == slot) return index;
+    }
+    return table.size();
+}
+
+long long RandomMoveOrder::exchange(long long slot, long long value) {
+    if (2 * (used + 1) > table.size()) grow();
+    size_t mask = table.size() - 1;
+    size_t index = home(slot);
+    while (current(index) && table[index].slot != slot) index = (index + 1) & mask;
+    long long previous = slot;
+    if (current(index)) {
+        previous = table[index].value;
+    } else {
+        used++;
+    }
+    table[index] = {slot, value, round};
+    return previous;
+}
+
+void RandomMoveOrder::erase(size_t index) {
+    // Backward shift: pull later entries of the probe run into the hole unless
+    // that would move them before their home bucket
+    size_t mask = table.size() - 1;
+    size_t hole = index;
+    for (size_t next = (hole + 1) & mask; current(next); next = (next + 1) & mask) {
+        if (((next - home(table[next].slot)) & mask) >= ((next - hole) & mask)) {
+            table[hole] = table[next];
+            hole = next;
+        }
+    }
+    table[hole].round = 0;
+    used--;
+}
+
+void RandomMoveOrder::grow() {
+    std::vector<Entry> old;
+    old.swap(table);
+    table.assign(std::max<size_t>(64, 2 * old.size()), Entry());
+    shift = 64;
+    for (size_t size = table.size(); size > 1; size >>= 1) shift--;
+    used = 0;
+    for (const Entry& entry : old) {
+        if (entry.round == round) exchange(entry.slot, entry.value);
+    }
+}
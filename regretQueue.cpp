@@ -0,0 +1,71 @@
+#include "include/regretQueue.h"
+#include "include/constants.h"
+#include <climits>
+#include <cmath>
+
+RegretQueue::RegretQueue(int n, double wRegret, double wBest)
+    : wRegret(wRegret), wBest(wBest), keys(n), indexOf(n, -1) {
+    heap.reserve(n);
+}
+
+bool RegretQueue::before(int a, int b) const {
+    const Key& ka = keys[a];
+    const Key& kb = keys[b];
+    if (std::abs(ka.score - kb.score) >= EPSILON) return ka.score > kb.score;
+    if (ka.best1 != kb.best1) return ka.best1 < kb.best1;
+    if (ka.regret != kb.regret) return ka.regret > kb.regret;
+    return a < b;
+}
+
+void RegretQueue::place(int index, int node) {
+    heap[index] = node;
+    indexOf[node] = index;
+}
+
+void RegretQueue::siftUp(int index) {
+    int node = heap[index];
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!before(node, heap[parent])) break;
+        place(index, heap[parent]);
+        index = parent;
+    }
+    place(index, node);
+}
+
+void RegretQueue::siftDown(int index) {
+    int node = heap[index];
+    int size = heap.size();
+    while (true) {
+        int child = 2 * index + 1;
+        if (child >= size) break;
+        if (child + 1 < size && before(heap[child + 1], heap[child])) child++;
+        if (!before(heap[child], node)) break;
+        place(index, heap[child]);
+        index = child;
+    }
+    place(index, node);
+}
+
+void RegretQueue::update(int node, int best1, int best2) {
+    int regret = best2 == INT_MAX ? 0 : best2 - best1;
+    keys[node] = {wRegret * regret - wBest * best1, best1, regret};
+    if (indexOf[node] < 0) {
+        heap.push_back(node);
+        indexOf[node] = heap.size() - 1;
+    }
+    siftUp(indexOf[node]);
+    siftDown(indexOf[node]);
+}
+
+void RegretQueue::remove(int node) {
+    int index = indexOf[node];
+    if (index < 0) return;
+    indexOf[node] = -1;
+    int last = heap.back();
+    heap.pop_back();
+    if (last == node) return;
+    place(index, last);
+    siftUp(index);
+    siftDown(indexOf[last]);
+}
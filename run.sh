@@ -1,6 +1,22 @@
-g++ -std=c++17 -O2 -I. \
+g++ -std=c++17 -O2 -march=native -pthread -I. $CXXFLAGS \
     main.cpp \
     calculateObjective.cpp \
+    insertionCache.cpp \
+    edgeGrid.cpp \
+    constructionBatch.cpp \
+    neighborRanking.cpp \
+    linkedTour.cpp \
+    twoLevelTour.cpp \
+    regretQueue.cpp \
+    minTree.cpp \
+    exchangeScan.cpp \
+    randomMoveOrder.cpp \
+    localSearchWorkspace.cpp \
+    localSearchCounters.cpp \
+    workerPool.cpp \
+    distanceMatrix.cpp \
+    mappedFile.cpp \
+    instance.cpp \
     algorithmEvaluator.cpp \
     assignment1/randomSolution.cpp \
     assignment1/nearestNeighborEnd.cpp \
@@ -8,13 +24,16 @@ g++ -std=c++17 -O2 -I. \
     assignment1/greedyCycle.cpp \
     assignment2/greedyRegret2.cpp \
     assignment2/greedyRegret2Weighted.cpp \
+    assignment2/greedyRegretK.cpp \
     assignment2/nearestNeighborAnyRegret2.cpp \
     assignment2/nearestNeighborAnyRegret2Weighted.cpp \
     assignment3/localSearch.cpp \
     assignment4/candidateMoves.cpp \
+    assignment4/localSearchDontLookBits.cpp \
     assignment5/localSearchLM.cpp \
     assignment5/localSearchLMCandidates.cpp \
     assignment6/multipleStartLS.cpp \
     assignment6/iteratedLS.cpp \
     assignment7/largeNeighborhoodSearch.cpp \
+    assignment8/globalConvexity.cpp \
     -o main && ./main | tee output.txt
\ No newline at end of file
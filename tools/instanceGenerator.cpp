@@ -0,0 +1,99 @@
+// Synthetic TSPA/TSPB-like instances for scaling experiments.
+//
+// TSPA and TSPB both place nodes uniformly in [0, 4000] x [0, 2000]; node costs
+// are uniform in [0, 2000] (TSPA) or [0, 1000] (TSPB). The clustered variant keeps
+// the cost distributions but draws coordinates from Gaussian clusters.
+//
+// Usage: instanceGenerator [outputDir] [n ...]
+//   defaults: input/generated, n = 1000 10000 100000
+// Files are named <family>_<layout>_<n>.csv, e.g. TSPA_clustered_10000.csv.
+// Every file has its own fixed seed and the generator only uses the raw
+// mt19937 stream, so the output is identical across compilers and runs.
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <filesystem>
+
+constexpr int MAX_X = 4000;
+constexpr int MAX_Y = 2000;
+constexpr unsigned DEFAULT_GENERATOR_SEED = 20241001;
+
+struct Family {
+    std::string name;
+    int maxCost;
+};
+
+// Uniform integer in [lo, hi]; std::uniform_int_distribution is implementation-defined
+static int uniformInt(std::mt19937& rng, int lo, int hi) {
+    return lo + (int)(rng() % (unsigned)(hi - lo + 1));
+}
+
+static double uniformReal(std::mt19937& rng) {
+    return (rng() + 0.5) / 4294967296.0;
+}
+
+// Box-Muller, one value per call
+static double gaussian(std::mt19937& rng) {
+    double u = uniformReal(rng), v = uniformReal(rng);
+    return std::sqrt(-2.0 * std::log(u)) * std::cos(2.0 * M_PI * v);
+}
+
+static void generate(const std::string& filename, int n, const Family& family, bool clustered, unsigned seed) {
+    std::mt19937 rng(seed);
+    
+    // About sqrt(n) clusters whose spread shrinks as they get more numerous
+    int clusters = std::max(4, (int)std::sqrt((double)n));
+    double sigmaX = MAX_X / (4.0 * std::sqrt((double)clusters));
+    double sigmaY = MAX_Y / (4.0 * std::sqrt((double)clusters));
+    std::vector<int> centerX(clusters), centerY(clusters);
+    for (int c = 0; c < clusters; c++) {
+        centerX[c] = uniformInt(rng, 0, MAX_X);
+        centerY[c] = uniformInt(rng, 0, MAX_Y);
+    }
+    
+    std::string buffer;
+    buffer.reserve((size_t)n * 16);
+    for (int i = 0; i < n; i++) {
+        int x, y;
+        if (clustered) {
+            int c = uniformInt(rng, 0, clusters - 1);
+            x = std::clamp((int)std::lround(centerX[c] + sigmaX * gaussian(rng)), 0, MAX_X);
+            y = std::clamp((int)std::lround(centerY[c] + sigmaY * gaussian(rng)), 0, MAX_Y);
+        } else {
+            x = uniformInt(rng, 0, MAX_X);
+            y = uniformInt(rng, 0, MAX_Y);
+        }
+        int cost = uniformInt(rng, 0, family.maxCost);
+        buffer += std::to_string(x) + ";" + std::to_string(y) + ";" + std::to_string(cost) + "\n";
+    }
+    std::ofstream fout(filename, std::ios::binary);
+    fout << buffer;
+}
+
+int main(int argc, char* argv[]) {
+    std::string outputDir = argc > 1 ? argv[1] : "input/generated";
+    std::vector<int> sizes;
+    for (int i = 2; i < argc; i++) {
+        sizes.push_back(std::stoi(argv[i]));
+    }
+    if (sizes.empty()) sizes = {1000, 10000, 100000};
+    
+    std::filesystem::create_directories(outputDir);
+    std::vector<Family> families = {{"TSPA", 2000}, {"TSPB", 1000}};
+    for (int f = 0; f < (int)families.size(); f++) {
+        for (int clustered = 0; clustered < 2; clustered++) {
+            for (int n : sizes) {
+                unsigned seed = DEFAULT_GENERATOR_SEED + n * 4 + f * 2 + clustered;
+                std::string filename = outputDir + "/" + families[f].name + (clustered ? "_clustered_" : "_uniform_")
+                                     + std::to_string(n) + ".csv";
+                generate(filename, n, families[f], clustered, seed);
+                std::cout << filename << " (seed " << seed << ")\n";
+            }
+        }
+    }
+    return 0;
+}
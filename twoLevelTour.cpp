@@ -0,0 +1,157 @@
+#include "include/twoLevelTour.h"
+#include <algorithm>
+#include <cmath>
+
+TwoLevelTour::TwoLevelTour(int n) : segmentOf(n, -1), indexOf(n, 0) {}
+
+void TwoLevelTour::resize(int n) {
+    if ((int)segmentOf.size() == n) return;
+    segmentOf.assign(n, -1);
+    indexOf.assign(n, 0);
+    order.clear();
+    count = 0;
+}
+
+void TwoLevelTour::reset(const std::vector<int>& nodes) {
+    for (int id : order) {
+        for (int node : segments[id].nodes) segmentOf[node] = -1;
+    }
+    count = nodes.size();
+    segmentSize = std::max(8, (int)std::sqrt((double)count));
+    int segmentCount = (count + segmentSize - 1) / segmentSize;
+    // A move splits at most two segments and the tour is rebalanced once there
+    // are more than twice segmentCount; splits only shrink segments
+    size_t pool = 2 * (size_t)segmentCount + 2;
+    if (segments.size() < pool) segments.resize(pool);
+    for (Segment& segment : segments) segment.nodes.reserve(segmentSize);
+    order.reserve(pool);
+    scratch.reserve(count);
+    order.resize(segmentCount);
+    for (int s = 0; s < segmentCount; s++) {
+        Segment& segment = segments[s];
+        int begin = s * segmentSize, end = std::min(count, begin + segmentSize);
+        segment.nodes.assign(nodes.begin() + begin, nodes.begin() + end);
+        segment.reversed = false;
+        segment.rank = s;
+        order[s] = s;
+        for (int i = 0; i < (int)segment.nodes.size(); i++) {
+            segmentOf[segment.nodes[i]] = s;
+            indexOf[segment.nodes[i]] = i;
+        }
+    }
+}
+
+int TwoLevelTour::next(int node) const {
+    const Segment& segment = segments[segmentOf[node]];
+    int position = positionOf(node);
+    if (position + 1 < (int)segment.nodes.size()) return nodeAt(segment, position + 1);
+    int rank = segment.rank + 1 == (int)order.size() ? 0 : segment.rank + 1;
+    return nodeAt(segments[order[rank]], 0);
+}
+
+int TwoLevelTour::prev(int node) const {
+    const Segment& segment = segments[segmentOf[node]];
+    int position = positionOf(node);
+    if (position > 0) return nodeAt(segment, position - 1);
+    int rank = segment.rank == 0 ? (int)order.size() - 1 : segment.rank - 1;
+    const Segment& previous = segments[order[rank]];
+    return nodeAt(previous, (int)previous.nodes.size() - 1);
+}
+
+bool TwoLevelTour::between(int a, int b, int c) const {
+    auto key = [&](int node) { return std::make_pair(segments[segmentOf[node]].rank, positionOf(node)); };
+    auto ka = key(a), kb = key(b), kc = key(c);
+    if (ka <= kc) return ka <= kb && kb <= kc;
+    return kb >= ka || kb <= kc;
+}
+
+void TwoLevelTour::splitBefore(int node) {
+    int id = segmentOf[node];
+    int position = positionOf(node);
+    if (position == 0) return;
+
+    // Both halves keep the stored order and the bit: the tail is the stored
+    // suffix, or the stored prefix if the segment is reversed
+    int tailId = order.size();
+    Segment& segment = segments[id];
+    Segment& tail = segments[tailId];
+    int rank = segment.rank;
+    tail.reversed = segment.reversed;
+    if (segment.reversed) {
+        int cut = (int)segment.nodes.size() - position;
+        tail.nodes.assign(segment.nodes.begin(), segment.nodes.begin() + cut);
+        segment.nodes.erase(segment.nodes.begin(), segment.nodes.begin() + cut);
+        for (int i = 0; i < (int)segment.nodes.size(); i++) indexOf[segment.nodes[i]] = i;
+    } else {
+        tail.nodes.assign(segment.nodes.begin() + position, segment.nodes.end());
+        segment.nodes.resize(position);
+    }
+    for (int i = 0; i < (int)tail.nodes.size(); i++) {
+        segmentOf[tail.nodes[i]] = tailId;
+        indexOf[tail.nodes[i]] = i;
+    }
+
+    order.insert(order.begin() + rank + 1, tailId);
+    for (int r = rank + 1; r < (int)order.size(); r++) segments[order[r]].rank = r;
+}
+
+void TwoLevelTour::reverseRun(int from, int length) {
+    int total = order.size();
+    for (int i = 0, j = length - 1; i < j; i++, j--) {
+        std::swap(order[(from + i) % total], order[(from + j) % total]);
+    }
+    for (int i = 0; i < length; i++) {
+        int rank = (from + i) % total;
+        Segment& segment = segments[order[rank]];
+        segment.reversed = !segment.reversed;
+        segment.rank = rank;
+    }
+}
+
+void TwoLevelTour::twoOptMove(int a, int c) {
+    int b = next(a), d = next(c);
+    if (a == c || b == c || d == a) return;
+
+    // Path b..c becomes a run of whole segments; reversing it or the
+    // complementary run d..a gives the same cycle
+    splitBefore(b);
+    splitBefore(d);
+    int total = order.size();
+    int first = segments[segmentOf[b]].rank, last = segments[segmentOf[c]].rank;
+    int length = (last - first + total) % total + 1;
+    if (2 * length <= total) {
+        reverseRun(first, length);
+    } else {
+        reverseRun((last + 1) % total, total - length);
+    }
+
+    if ((int)order.size() > 2 * ((count + segmentSize - 1) / segmentSize)) rebalance();
+}
+
+void TwoLevelTour::rebalance() {
+    toVector(scratch);
+    reset(scratch);
+}
+
+void TwoLevelTour::replace(int oldNode, int newNode) {
+    int id = segmentOf[oldNode];
+    segments[id].nodes[indexOf[oldNode]] = newNode;
+    segmentOf[newNode] = id;
+    indexOf[newNode] = indexOf[oldNode];
+    segmentOf[oldNode] = -1;
+}
+
+std::vector<int> TwoLevelTour::toVector() const {
+    std::vector<int> nodes;
+    toVector(nodes);
+    return nodes;
+}
+
+void TwoLevelTour::toVector(std::vector<int>& nodes) const {
+    nodes.clear();
+    nodes.reserve(count);
+    for (int id : order) {
+        const Segment& segment = segments[id];
+        for (int i = 0; i < (int)segment.nodes.size(); i++) nodes.push_back(nodeAt(segment, i));
+    }
+}
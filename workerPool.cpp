@@ -0,0 +1,62 @@
+#include "include/workerPool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(int threads) {
+    for (int t = 1; t < threads; t++) workers.emplace_back(&WorkerPool::workerLoop, this);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+void WorkerPool::dispatch(int newCount, Trampoline newTrampoline, void* newContext) {
+    if (workers.empty() || newCount <= 1) {
+        if (newCount > 0) newTrampoline(newContext, 0, newCount);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        trampoline = newTrampoline;
+        context = newContext;
+        count = newCount;
+        // Several chunks per thread so that uneven rows even out
+        chunk = std::max(1, newCount / (8 * threads()));
+        nextBegin = 0;
+        busy = workers.size();
+        if (++generation == 0) generation = 1;
+    }
+    wake.notify_all();
+    work();
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&]() { return busy == 0; });
+}
+
+void WorkerPool::work() {
+    for (int begin = nextBegin.fetch_add(chunk); begin < count; begin = nextBegin.fetch_add(chunk)) {
+        trampoline(context, begin, std::min(count, begin + chunk));
+    }
+}
+
+void WorkerPool::workerLoop() {
+    unsigned seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        work();
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            last = --busy == 0;
+        }
+        if (last) finished.notify_one();
+    }
+}